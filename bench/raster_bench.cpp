@@ -0,0 +1,306 @@
+// Microbenchmarks dos caminhos quentes da rasterização: fill_polygon (por
+// modo de shading, caminho de raster e tamanho), plot_line (larguras 1-10),
+// clipPolygon2D (fração crescente fora da tela), projeção de vértices e
+// clear/clearDepth. Cada caso roda até somar --min-ms de tempo e imprime
+// o custo por chamada e por unidade (pixel ou vértice).
+//
+// uso: raster_bench [--min-ms N] [filtro]
+//   filtro: só roda os casos cujo nome contém o texto (ex.: "fill/phong")
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../include/bresenham.h"
+#include "../include/camera.h"
+#include "../include/crop_sutherland_hodgman.h"
+#include "../include/fill_polygon.h"
+#include "../include/frame_arena.h"
+#include "../include/framebuffer.h"
+#include "../include/renderer.h"
+#include "../include/types.h"
+#include "../include/vertex_stream.h"
+
+static const int W = 900, H = 600;  // tamanho padrão da janela do app
+static double minMs = 200.0;
+static const char* filter = nullptr;
+
+// Roda f() em lotes dobrando de tamanho até passar de minMs; devolve ns
+// por chamada. Uma chamada antes, fora do tempo, aquece caches e os
+// buffers internos (RasterContext, arena).
+template <class F>
+static double timeIt(F&& f) {
+    using clock = std::chrono::steady_clock;
+    f();
+    long iters = 1;
+    for (;;) {
+        auto t0 = clock::now();
+        for (long i = 0; i < iters; i++) f();
+        double ms = std::chrono::duration<double, std::milli>(clock::now() - t0)
+                        .count();
+        if (ms >= minMs) return ms * 1e6 / iters;
+        iters *= (ms < minMs / 8) ? 8 : 2;
+    }
+}
+
+static bool selected(const std::string& name) {
+    return !filter || name.find(filter) != std::string::npos;
+}
+
+// work = pixels ou vértices por chamada
+static void report(const std::string& name, double nsPerCall, double work,
+                   const char* unit) {
+    std::printf("%-36s %12.1f ns/chamada %10.3f ns/%s\n", name.c_str(),
+                nsPerCall, nsPerCall / work, unit);
+}
+
+// pixels cujo depth saiu do valor de clearDepth
+static long touchedPixels(Framebuffer& fb, float cleared) {
+    long n = 0;
+    const float* z = fb.depthData();
+    for (int i = 0; i < fb.width() * fb.height(); i++)
+        if (z[i] != cleared) n++;
+    return n;
+}
+
+// ---------------- fill_polygon ----------------
+
+// Quadrado de lado side girado 30 graus no centro da tela, com normais e
+// intensidades variando para Gouraud/Phong interpolarem algo real
+static std::vector<Vertex2D> quad(float side) {
+    std::vector<Vertex2D> v;
+    float r = side * 0.70710678f;
+    for (int k = 0; k < 4; k++) {
+        float a = glm::radians(30.0f + 90.0f * k + 45.0f);
+        Vertex2D p;
+        p.x = int(std::lround(W / 2 + r * std::cos(a)));
+        p.y = int(std::lround(H / 2 + r * std::sin(a)));
+        p.z = 0.0f;
+        p.normal = glm::normalize(glm::vec3(std::cos(a), std::sin(a), 2.0f));
+        p.intensity = 0.3f + 0.15f * k;
+        v.push_back(p);
+    }
+    return v;
+}
+
+static void benchFill() {
+    struct ModeCase {
+        const char* name;
+        ShadingMode mode;
+        bool fast;
+    };
+    const ModeCase modes[] = {{"flat", ShadingMode::Flat, false},
+                              {"gouraud", ShadingMode::Gouraud, false},
+                              {"phong", ShadingMode::Phong, false},
+                              {"phong-fast", ShadingMode::Phong, true}};
+    const struct {
+        const char* name;
+        RasterPath path;
+    } paths[] = {{"scanline", RasterPath::Scanline},
+                 {"halfspace", RasterPath::HalfSpace}};
+    const int sizes[] = {8, 32, 128, 384};  // 384 girado ainda cabe em 600
+
+    Framebuffer fb(W, H);
+    Renderer renderer;
+    Light light;
+    light.pos = glm::vec3(W / 2, H / 2, 400.0f);
+    renderer.setLight(light);
+    renderer.setCameraEye(glm::vec3(W / 2, H / 2, 600.0f));
+    Material material = MATERIAL_PLASTIC;
+    renderer.setFlatIntensity(0.8f);
+    RasterContext ctx;
+
+    for (const auto& m : modes) {
+        for (const auto& p : paths) {
+            for (int size : sizes) {
+                std::string name = std::string("fill/") + m.name + "/" +
+                                   p.name + "/" + std::to_string(size);
+                if (!selected(name)) continue;
+
+                renderer.setMode(m.mode);
+                renderer.setRasterPath(p.path);
+                renderer.setFastMath(m.fast);
+                // as tabelas só existem com fast math ligado: sem elas o
+                // caso "fast" mediria o caminho exato
+                renderer.prepareMaterial(material);
+                if (m.fast && !material.table) {
+                    std::fprintf(stderr, "%s: material sem tabelas de fast "
+                                         "math\n", name.c_str());
+                    std::exit(1);
+                }
+
+                std::vector<Vertex2D> verts = quad(float(size));
+                Polygon poly;
+                poly.verts = {verts.data(), verts.size()};
+                poly.material = &material;
+
+                // z cai a cada chamada: todo pixel passa no teste de
+                // profundidade sem limpar o depth no meio da medida
+                fb.clearDepth(1000.0f);
+                fill_polygon(poly, fb, renderer, ctx);
+                long pixels = touchedPixels(fb, 1000.0f);
+
+                fb.clearDepth(1000.0f);
+                float z = 999.0f;
+                double ns = timeIt([&] {
+                    z -= 1e-3f;
+                    for (auto& v : verts) v.z = z;
+                    fill_polygon(poly, fb, renderer, ctx);
+                });
+                report(name, ns, double(pixels), "px");
+            }
+        }
+    }
+}
+
+// ---------------- plot_line ----------------
+
+static void benchLines() {
+    Framebuffer fb(W, H);
+    for (int width = 1; width <= 10; width++) {
+        std::string name = "line/w" + std::to_string(width);
+        if (!selected(name)) continue;
+
+        // diagonal rasa (dx > dy), longe das bordas para nenhuma largura
+        // recortar
+        Line2D l{50, 100, W - 50, H - 150, 0.0f, 0.0f, {255, 255, 255, 255},
+                 width};
+        double length = std::max(std::abs(l.x2 - l.x1), std::abs(l.y2 - l.y1)) + 1;
+
+        fb.clearDepth(1000.0f);
+        float z = 999.0f;
+        double ns = timeIt([&] {
+            z -= 1e-3f;
+            l.z1 = l.z2 = z;
+            plot_line(l, fb);
+        });
+        report(name, ns, length, "px");
+    }
+}
+
+// ---------------- clipPolygon2D ----------------
+
+static void benchClip() {
+    const int N = 32;
+    const float R = 200.0f;
+    FrameArena arena;
+
+    // o centro desliza para a direita: 0% até ~100% do disco fora da tela
+    const int outside[] = {0, 25, 50, 75, 100};
+    for (int pct : outside) {
+        std::string name = "clip/out" + std::to_string(pct);
+        if (!selected(name)) continue;
+
+        // fração da largura 2R do disco que passa da borda direita
+        float cx = (W - 1) - R + 2.0f * R * pct / 100.0f;
+        std::vector<Vertex2D> verts(N);
+        for (int k = 0; k < N; k++) {
+            float a = 2.0f * 3.14159265f * k / N;
+            verts[k].x = int(cx + R * std::cos(a));
+            verts[k].y = int(H / 2 + R * std::sin(a));
+            verts[k].z = 1.0f;
+            verts[k].normal = glm::vec3(0, 0, 1);
+            verts[k].intensity = 0.5f;
+        }
+        Polygon poly;
+        poly.verts = {verts.data(), verts.size()};
+
+        volatile size_t sink = 0;
+        double ns = timeIt([&] {
+            arena.reset();
+            sink = sink + clipPolygon2D(poly, W, H, arena).verts.size();
+        });
+        report(name, ns, N, "vert");
+    }
+}
+
+// ---------------- projeção ----------------
+
+static void benchProject() {
+    const int N = 4096;
+    Camera camera;
+    camera.addX(30);
+    camera.addY(20);
+    FrameTransform ft = camera.frameTransform(W, H);
+
+    // pontos espalhados no volume visível em torno da origem
+    Polyhedron mesh;
+    std::srand(1);
+    auto rnd = [] { return std::rand() / float(RAND_MAX) * 6.0f - 3.0f; };
+    for (int i = 0; i < N; i++) {
+        Vertex3D v;
+        v.position = glm::vec3(rnd(), rnd(), rnd());
+        v.normal = glm::normalize(v.position + glm::vec3(0.01f));
+        mesh.verts.push_back(v);
+    }
+
+    if (selected("project/vertex")) {
+        std::vector<Vertex2D> out(N);
+        double ns = timeIt([&] {
+            for (int i = 0; i < N; i++)
+                Camera::projectVertex(ft, mesh.verts[i].position,
+                                      mesh.verts[i].normal, out[i]);
+        });
+        report("project/vertex", ns, N, "vert");
+    }
+
+    VertexCache cache;
+    if (selected("project/verts")) {
+        double ns = timeIt([&] { Camera::projectVerts(ft, mesh, cache); });
+        report("project/verts", ns, N, "vert");
+    }
+
+    if (selected("project/stream")) {
+        VertexStream stream;
+        stream.assign(mesh.verts);
+        double ns = timeIt([&] { project_stream(stream, ft, cache); });
+        report("project/stream", ns, N, "vert");
+    }
+}
+
+// ---------------- clear ----------------
+
+static void benchClear() {
+    const struct {
+        int w, h;
+    } sizes[] = {{W, H}, {1920, 1080}};
+    for (const auto& s : sizes) {
+        std::string res = std::to_string(s.w) + "x" + std::to_string(s.h);
+        Framebuffer fb(s.w, s.h);
+        double pixels = double(s.w) * s.h;
+
+        if (selected("clear/color/" + res)) {
+            double ns = timeIt([&] { fb.clear({30, 30, 40, 255}); });
+            report("clear/color/" + res, ns, pixels, "px");
+        }
+        if (selected("clear/depth/" + res)) {
+            double ns = timeIt([&] { fb.clearDepth(1000.0f); });
+            report("clear/depth/" + res, ns, pixels, "px");
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--min-ms") == 0 && i + 1 < argc) {
+            minMs = std::atof(argv[++i]);
+        } else if (argv[i][0] != '-' && !filter) {
+            filter = argv[i];
+        } else {
+            std::fprintf(stderr, "uso: raster_bench [--min-ms N] [filtro]\n");
+            return -1;
+        }
+    }
+
+    benchFill();
+    benchLines();
+    benchClip();
+    benchProject();
+    benchClear();
+    return 0;
+}
@@ -3,4 +3,5 @@
 #include "../include/draw.h"
 #include <math.h>
 
-void plot_line(const Line2D& l, Framebuffer& fb);
+// devolve quantos pixels passaram no z-test e foram escritos
+int plot_line(const Line2D& l, Framebuffer& fb);
@@ -0,0 +1,134 @@
+#pragma once
+#include <cassert>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "../include/camera.h"
+#include "../include/types.h"
+
+// BVH dinâmica sobre os bounds dos objetos (árvore de AABBs balanceada por
+// rotações, no estilo da b2DynamicTree do Box2D). Cada folha guarda uma
+// caixa "gorda": enquanto o objeto se move dentro dela, update() não mexe
+// na árvore; só quando escapa a folha é removida e reinserida (O(log n)).
+class Bvh {
+public:
+    static constexpr int NONE = -1;
+    // pilha das consultas (fica na pilha do chamador, sem alocar): a DFS
+    // guarda no máximo height + 1 nós, e a árvore balanceada com altura 64
+    // teria bilhões de folhas
+    static constexpr int STACK = 64;
+
+    // devolve o proxy (nó folha) do objeto id
+    int insert(int id, const Bounds& b);
+    void remove(int proxy);
+    // refit depois de transformar o objeto; true se a folha foi reinserida
+    bool update(int proxy, const Bounds& b);
+    void clear();
+
+    int height() const { return root == NONE ? 0 : nodes[root].height; }
+
+    // visit(id) para cada folha cuja caixa gorda intersecta o frustum;
+    // subárvores fora do frustum são descartadas inteiras
+    template <class F>
+    void queryFrustum(const FrameTransform& ft, F&& visit) const;
+
+    // percorre as folhas atingidas pelo raio em ordem aproximada de
+    // distância; hit(id, tMax) devolve o novo tMax (distância do acerto
+    // mais próximo até agora), o que poda as caixas mais distantes
+    template <class F>
+    void raycast(const glm::vec3& origin, const glm::vec3& dir, float tMax,
+                 F&& hit) const;
+
+private:
+    struct Node {
+        glm::vec3 min{0}, max{0};
+        int parent = NONE;  // na lista livre: próximo nó livre
+        int child[2] = {NONE, NONE};
+        int id = NONE;      // só folhas
+        int height = 0;     // folha = 0, livre = -1
+
+        bool leaf() const { return child[0] == NONE; }
+    };
+
+    std::vector<Node> nodes;
+    int root = NONE;
+    int freeList = NONE;
+
+    int allocate();
+    void release(int n);
+    void insertLeaf(int leaf);
+    void removeLeaf(int leaf);
+    int balance(int a);
+    void refit(int n);
+    void replaceChild(int parent, int oldChild, int newChild);
+
+    static bool rayBox(const Node& n, const glm::vec3& o,
+                       const glm::vec3& inv, float tMax, float& tEnter);
+};
+
+template <class F>
+void Bvh::queryFrustum(const FrameTransform& ft, F&& visit) const {
+    if (root == NONE) return;
+
+    assert(height() < STACK);
+    int stack[STACK];
+    int top = 0;
+    stack[top++] = root;
+    while (top > 0) {
+        const Node& n = nodes[stack[--top]];
+
+        Bounds b;
+        b.min = n.min;
+        b.max = n.max;
+        b.center = (n.min + n.max) * 0.5f;
+        b.radius = glm::length(n.max - n.min) * 0.5f;
+        if (!Camera::inFrustum(ft, b)) continue;
+
+        if (n.leaf()) {
+            visit(n.id);
+        } else {
+            stack[top++] = n.child[0];
+            stack[top++] = n.child[1];
+        }
+    }
+}
+
+template <class F>
+void Bvh::raycast(const glm::vec3& origin, const glm::vec3& dir, float tMax,
+                  F&& hit) const {
+    if (root == NONE) return;
+
+    // 1/0 vira inf e o slab test continua valendo para eixos paralelos
+    glm::vec3 inv(1.0f / dir.x, 1.0f / dir.y, 1.0f / dir.z);
+
+    assert(height() < STACK);
+    int stack[STACK];
+    int top = 0;
+    stack[top++] = root;
+    while (top > 0) {
+        const Node& n = nodes[stack[--top]];
+
+        float t;
+        if (!rayBox(n, origin, inv, tMax, t)) continue;
+
+        if (n.leaf()) {
+            tMax = hit(n.id, tMax);
+            continue;
+        }
+
+        // filho mais próximo no topo da pilha: acha cedo um acerto e poda
+        // o outro lado
+        float t0, t1;
+        bool h0 = rayBox(nodes[n.child[0]], origin, inv, tMax, t0);
+        bool h1 = rayBox(nodes[n.child[1]], origin, inv, tMax, t1);
+        if (h0 && h1) {
+            bool near0 = t0 <= t1;
+            stack[top++] = n.child[near0 ? 1 : 0];
+            stack[top++] = n.child[near0 ? 0 : 1];
+        } else if (h0) {
+            stack[top++] = n.child[0];
+        } else if (h1) {
+            stack[top++] = n.child[1];
+        }
+    }
+}
@@ -1,10 +1,59 @@
 #pragma once
+#include <cstdint>
+#include <vector>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
 #include "crop_sutherland_hodgman.h"
 #include "types.h"
 
+// Guard band em NDC: faces dentro de [-GUARD_BAND, GUARD_BAND] não são
+// recortadas em clip space, só na tela (clipPolygon2D)
+constexpr float GUARD_BAND = 2.0f;
+
+// View e constantes da projeção de um frame: montadas uma vez por
+// Camera::frameTransform em vez de a cada vértice
+struct FrameTransform {
+    glm::mat4 view;
+    bool ortho;
+    float sx, sy;  // clip = (x * sx, y * sy); ortho: 1/halfW, 1/halfH;
+                   // perspectiva: f/aspect, f
+    float nearp, farp;
+    int W, H;
+
+    glm::vec3 eye;      // posição da câmera (culling em perspectiva)
+    glm::vec3 forward;  // direção de visão (culling em ortho)
+
+    // normais dos vértices -> mundo (iluminação); identidade no frame,
+    // inversa transposta do model numa instância
+    glm::mat3 normalMatrix{1.0f};
+};
+
+// Vértice em clip space: ndc = (x / w, y / w); d = distância à câmera (o z
+// do Vertex2D). Em ortho w = 1.
+struct ClipVertex {
+    float x, y, d, w;
+};
+
+// bits de VertexCache::outcode: de que lado de cada plano o vértice está
+enum ClipCode : uint8_t {
+    CLIP_NEAR = 1,
+    CLIP_FAR = 2,
+    CLIP_LEFT = 4,    // x < -GUARD_BAND * w
+    CLIP_RIGHT = 8,   // x >  GUARD_BAND * w
+    CLIP_BOTTOM = 16,
+    CLIP_TOP = 32
+};
+
+// Vértices de um Polyhedron já projetados, um por entrada de verts. As faces
+// são montadas a partir daqui, então vértice compartilhado é projetado 1 vez.
+struct VertexCache {
+    std::vector<Vertex2D> verts;     // x/y/z só valem com outcode 0; a normal
+                                     // vale sempre (recorte em clip space)
+    std::vector<ClipVertex> clip;
+    std::vector<uint8_t> outcode;
+};
+
 class Camera {
    public:
     enum class ProjType { Ortho, Perspective };
@@ -26,11 +75,61 @@ class Camera {
     bool projectVertex(const glm::vec3& pos, const glm::vec3& normal,
                        Vertex2D& out, int W, int H) const;
 
+    FrameTransform frameTransform(int W, int H) const;
+
+    static bool projectVertex(const FrameTransform& ft, const glm::vec3& pos,
+                              const glm::vec3& normal, Vertex2D& out);
+
+    // view + projeção sem dividir por w; devolve o outcode do vértice
+    static uint8_t clipVertex(const FrameTransform& ft, const glm::vec3& pos,
+                              ClipVertex& out);
+
+    // divisão por w + viewport (só para vértices dentro do guard band)
+    static void toScreen(const FrameTransform& ft, const ClipVertex& c,
+                         Vertex2D& out);
+
+    // face de costas para a câmera? Em perspectiva compara com o olho, em
+    // ortho com a direção de visão (raios paralelos)
+    static bool backFacing(const FrameTransform& ft, const glm::vec4& plane) {
+        if (ft.ortho) return glm::dot(glm::vec3(plane), ft.forward) > 0.0f;
+        return glm::dot(glm::vec3(plane), ft.eye) + plane.w < 0.0f;
+    }
+
+    // objeto possivelmente visível? Testa esfera e depois AABB contra near,
+    // far e os 4 lados da tela
+    static bool inFrustum(const FrameTransform& ft, const Bounds& b);
+
+    // frame de uma instância: view = view * model e eye/forward em espaço
+    // do objeto, para projetar e fazer backface culling direto dos vértices
+    // e planos do mesh compartilhado. Bounds/frustum/LOD continuam no frame
+    // de mundo.
+    static FrameTransform instanceTransform(const FrameTransform& ft,
+                                            const glm::mat4& model);
+
+    // raio da esfera de b projetado na tela, em pixels (escolha de LOD);
+    // infinito se o centro está antes do near
+    static float screenRadius(const FrameTransform& ft, const Bounds& b);
+
+    // projeta todos os vértices do objeto para o cache
+    static void projectVerts(const FrameTransform& ft, const Polyhedron& obj,
+                             VertexCache& cache);
+
+    // Monta a face a partir do cache. Vértices fora de near/far ou do guard
+    // band são recortados em clip space antes da divisão por w; o que
+    // sobra passa pelo recorte na tela (que pula faces já dentro dela).
+    // Os vértices do polígono ficam na arena do frame.
+    static Polygon assembleAndClip(const FrameTransform& ft,
+                                   const Polyhedron& obj, const Face& face,
+                                   const VertexCache& cache,
+                                   FrameArena& arena);
+
     Polygon projectFace(const Polyhedron& obj, const Face& face, int W,
-                        int H) const;
+                        int H, FrameArena& arena) const;
 
+    // uma face isolada: projeta só os vértices dela (o laço de desenho usa
+    // projectVerts + assembleAndClip, que projeta cada vértice uma vez)
     Polygon projectAndClip(const Polyhedron& obj, const Face& face, int W,
-                           int H) const;
+                           int H, FrameArena& arena) const;
 
     bool projectLine(const Line3D& l3, Line2D& out, int W, int H) const;
 
@@ -47,6 +146,9 @@ class Camera {
             addPitch(deltaDeg);
     }
 
+    // pose de órbita absoluta em torno de look (cenas de arquivo)
+    void setOrbit(float azimuthDeg, float elevationDeg, float distance);
+
     void addOrbitDistance(float delta) {
         orbitDistance += delta;
         if (orbitDistance < 0.1f) orbitDistance = 0.1f;
@@ -0,0 +1,49 @@
+#pragma once
+#include <algorithm>
+#include <vector>
+
+// Par de buffers ping-pong para recorte de polígonos (Sutherland-Hodgman).
+// Ficam na pilha enquanto cabem em CAP vértices; acima disso passam para
+// vetores por thread, que só crescem, então o recorte não aloca depois de
+// aquecido. Numa passada contra um plano, um polígono convexo de n vértices
+// sai com no máximo n + 1; 2n é o limite para polígonos arbitrários.
+template <class T, int CAP = 64>
+struct ClipBuffers {
+    T* in;   // polígono atual
+    T* out;  // destino da próxima passada
+
+    ClipBuffers() : in(stackA), out(stackB) {}
+
+    // garante espaço para uma passada que lê n vértices de in
+    void reserve(int n) {
+        int need = 2 * n;
+        if (need <= cap) return;
+
+        std::vector<T>& a = heapA();
+        std::vector<T>& b = heapB();
+        bool onStack = (in == stackA || in == stackB);
+        bool inA = !onStack && in == a.data();
+
+        if (onStack) {
+            a.resize(need);
+            std::copy(in, in + n, a.begin());
+            inA = true;
+        } else {
+            (inA ? a : b).resize(need);  // resize preserva o conteúdo
+        }
+        (inA ? b : a).resize(need);
+
+        in = inA ? a.data() : b.data();
+        out = inA ? b.data() : a.data();
+        cap = need;
+    }
+
+    void swap() { std::swap(in, out); }
+
+   private:
+    T stackA[CAP], stackB[CAP];
+    int cap = CAP;
+
+    static std::vector<T>& heapA() { static thread_local std::vector<T> v; return v; }
+    static std::vector<T>& heapB() { static thread_local std::vector<T> v; return v; }
+};
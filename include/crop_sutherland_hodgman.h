@@ -2,8 +2,14 @@
 #include <vector>
 #include <glm/vec3.hpp>
 
+#include "frame_arena.h"
 #include "types.h"
 
 // Recorta um polígono 2D contra a viewport [0..W-1] x [0..H-1].
-// Retorna polígono novo (pode voltar vazio).
-Polygon clipPolygon2D(const Polygon& in, int W, int H);
+// Retorna polígono novo com vértices na arena (pode voltar vazio).
+Polygon clipPolygon2D(const Polygon& in, int W, int H, FrameArena& arena);
+
+// Mesmo recorte, reaproveitando poly.verts. Se a bbox já está dentro da
+// tela não faz nada; senão recorta em buffers na pilha e, se o resultado
+// não cabe no lugar, pega o espaço da arena.
+void clipPolygon2DInPlace(Polygon& poly, int W, int H, FrameArena& arena);
@@ -19,7 +19,8 @@ static inline int write_pixel_z(int x, int y, float z, Color c,
 
 void write_pixel_dilated(int x, int y, Color c, int width, Framebuffer& fb);
 
-void write_pixel_dilated_z(int x, int y, float z, Color c, int width,
-                           Framebuffer& fb);
+// devolve quantos pixels foram escritos
+int write_pixel_dilated_z(int x, int y, float z, Color c, int width,
+                          Framebuffer& fb);
 
 #endif
@@ -0,0 +1,142 @@
+#pragma once
+#include <algorithm>
+
+#include "../include/types.h"
+#include "../include/draw.h"
+#include "../include/raster_stats.h"
+#include "../include/renderer.h"
+
+// ------------------------- EDGE FUNCTIONS -------------------------
+
+// E(p) = dx*(p.y - y0) - dy*(p.x - x0) para a aresta (x0,y0) -> (x0+dx,y0+dy)
+// passo incremental: E(x+1, y) = E - dy   |   E(x, y+1) = E + dx
+struct edge_fn {
+    int x0, y0;
+    int dx, dy;
+    int bias;  // 0 se a aresta é top-left, -1 caso contrário
+
+    int eval(int x, int y) const { return dx * (y - y0) - dy * (x - x0) + bias; }
+};
+
+inline edge_fn make_edge(const Vertex2D& a, const Vertex2D& b) {
+    edge_fn e;
+    e.x0 = a.x;
+    e.y0 = a.y;
+    e.dx = b.x - a.x;
+    e.dy = b.y - a.y;
+
+    // regra top-left: uma aresta compartilhada é percorrida em sentidos
+    // opostos pelos dois triângulos, então só um deles fica com os pixels
+    bool topLeft = (e.dy < 0) || (e.dy == 0 && e.dx > 0);
+    e.bias = topLeft ? 0 : -1;
+    return e;
+}
+
+// Percorre os pixels cobertos pelo triângulo (a, b, c) dentro da tela WxH e
+// do clip, em blocos 8x8: blocos totalmente fora são descartados, totalmente
+// dentro são varridos sem teste, e os parciais são testados pixel a pixel.
+// pixel(x, y, la, lb, lc) recebe as baricêntricas de a, b e c.
+template <class PixelFn>
+void halfspace_traverse(const Vertex2D& a, const Vertex2D& b,
+                        const Vertex2D& c, int W, int H,
+                        const ScreenRect& clip, PixelFn&& pixel)
+{
+    const int BLOCK = 8;  // lado do bloco (potência de 2)
+
+    const Vertex2D* v0 = &a;
+    const Vertex2D* v1 = &b;
+    const Vertex2D* v2 = &c;
+
+    int area = (v1->x - v0->x) * (v2->y - v0->y) -
+               (v1->y - v0->y) * (v2->x - v0->x);
+    if (area == 0) return;  // degenerado
+
+    bool swapped = area < 0;
+    if (swapped) {
+        std::swap(v1, v2);
+        area = -area;
+    }
+
+    // cada aresta fica oposta ao vértice de mesmo índice
+    edge_fn e0 = make_edge(*v1, *v2);
+    edge_fn e1 = make_edge(*v2, *v0);
+    edge_fn e2 = make_edge(*v0, *v1);
+
+    int minX = std::max(std::min({v0->x, v1->x, v2->x}), std::max(clip.x0, 0));
+    int maxX = std::min(std::max({v0->x, v1->x, v2->x}), std::min(clip.x1, W - 1));
+    int minY = std::max(std::min({v0->y, v1->y, v2->y}), std::max(clip.y0, 0));
+    int maxY = std::min(std::max({v0->y, v1->y, v2->y}), std::min(clip.y1, H - 1));
+    if (minX > maxX || minY > maxY) return;
+
+    float invArea = 1.0f / float(area);
+
+    auto emit = [&](int x, int y, int w0, int w1, int w2) {
+        // baricêntricas (sem o bias da regra de preenchimento)
+        float l0 = float(w0 - e0.bias) * invArea;
+        float l1 = float(w1 - e1.bias) * invArea;
+        float l2 = float(w2 - e2.bias) * invArea;
+
+        if (swapped) pixel(x, y, l0, l2, l1);
+        else pixel(x, y, l0, l1, l2);
+    };
+
+    for (int by = minY & ~(BLOCK - 1); by <= maxY; by += BLOCK) {
+        for (int bx = minX & ~(BLOCK - 1); bx <= maxX; bx += BLOCK) {
+            int bx1 = bx + BLOCK - 1;
+            int by1 = by + BLOCK - 1;
+
+            // avalia as 3 arestas nos 4 cantos do bloco
+            bool reject = false;
+            bool accept = true;
+            for (const edge_fn* e : {&e0, &e1, &e2}) {
+                int c00 = e->eval(bx, by), c10 = e->eval(bx1, by);
+                int c01 = e->eval(bx, by1), c11 = e->eval(bx1, by1);
+                int lo = std::min({c00, c10, c01, c11});
+                int hi = std::max({c00, c10, c01, c11});
+                if (hi < 0) { reject = true; break; }  // bloco todo fora
+                if (lo < 0) accept = false;           // aresta corta o bloco
+            }
+            if (reject) continue;
+
+            int x0 = std::max(bx, minX), x1 = std::min(bx1, maxX);
+            int y0 = std::max(by, minY), y1 = std::min(by1, maxY);
+
+            int r0 = e0.eval(x0, y0);
+            int r1 = e1.eval(x0, y0);
+            int r2 = e2.eval(x0, y0);
+
+            for (int y = y0; y <= y1; y++) {
+                int w0 = r0, w1 = r1, w2 = r2;
+
+                for (int x = x0; x <= x1; x++) {
+                    // bloco aceito: sem teste; parcial: sinal das 3 arestas
+                    if (accept || (w0 | w1 | w2) >= 0) emit(x, y, w0, w1, w2);
+
+                    w0 -= e0.dy;
+                    w1 -= e1.dy;
+                    w2 -= e2.dy;
+                }
+
+                r0 += e0.dx;
+                r1 += e1.dx;
+                r2 += e2.dx;
+            }
+        }
+    }
+}
+
+// Rasteriza e ilumina um triângulo com halfspace_traverse; soma os pixels
+// em stats, se houver.
+void fill_triangle_halfspace(const Vertex2D& a, const Vertex2D& b,
+                             const Vertex2D& c, const Material& mat,
+                             Framebuffer& fb, Renderer& renderer,
+                             const ScreenRect& clip = ScreenRect(),
+                             RasterStats* stats = nullptr);
+
+// Quebra o polígono em leque (v0, vi, vi+1) e rasteriza cada triângulo.
+// Retorna false (sem desenhar nada) se o polígono não for convexo ou se
+// cruzar consigo mesmo (p. ex. pentagrama).
+bool fill_polygon_halfspace(const Polygon& p, Framebuffer& fb,
+                            Renderer& renderer,
+                            const ScreenRect& clip = ScreenRect(),
+                            RasterStats* stats = nullptr);
@@ -1,6 +1,9 @@
 #pragma once
+#include <vector>
+
 #include "../include/types.h"
 #include "../include/draw.h"
+#include "../include/raster_stats.h"
 #include "../include/renderer.h"
 
 struct frac {
@@ -14,4 +17,36 @@ struct node {
     frac m_inv;
 };
 
+struct node_z {
+    int ymin;
+    int ymax;
+    frac xmin;
+    frac m_inv;
+
+    float z_min;
+    float dz_dy;
+
+    float i_min;      // intensidade por vértice (Gouraud)
+    float di_dy;
+
+    glm::vec3 n_min;  // normal na aresta (Phong)
+    glm::vec3 dn_dy;
+};
+
+// Memória de trabalho do scanline (ET/AET) reaproveitada entre chamadas.
+// Os vetores só crescem: depois de aquecido, preencher um polígono não aloca.
+struct RasterContext {
+    std::vector<node_z> edges;  // arestas do polígono, na ordem dos vértices
+    std::vector<node_z> et;     // ET: arestas agrupadas por ymin, contíguas
+    std::vector<int> etStart;   // offset de cada scanline [min_y..max_y+1] em et
+    std::vector<node_z> aet;    // AET: arestas ativas ordenadas por xmin
+
+    ScreenRect clip;            // só escreve pixels dentro deste retângulo
+    RasterStats stats;          // contadores somados por quem preenche
+};
+
+void fill_polygon(const Polygon& p, Framebuffer& fb, Renderer& renderer,
+                  RasterContext& ctx);
+
+// usa um contexto interno (um por thread)
 void fill_polygon(const Polygon& p, Framebuffer& fb, Renderer& renderer);
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// Alocador linear para os dados temporários de um frame (vértices dos
+// polígonos projetados e recortados). alloc() só avança um ponteiro e nada é
+// liberado sozinho: reset() devolve tudo de uma vez no começo do próximo
+// frame. Se um frame precisou de mais de um bloco, o reset junta tudo num
+// bloco só do tamanho somado, então depois de aquecido não há malloc.
+class FrameArena {
+public:
+    explicit FrameArena(size_t initialBytes = 256 * 1024);
+
+    // n objetos T inicializados por default; valem até o próximo reset()
+    template <class T>
+    T* alloc(size_t n) {
+        static_assert(std::is_trivially_destructible<T>::value,
+                      "FrameArena não chama destrutores");
+        static_assert(alignof(T) <= alignof(std::max_align_t),
+                      "alinhamento maior que o dos blocos");
+        T* p = static_cast<T*>(allocBytes(n * sizeof(T), alignof(T)));
+        std::uninitialized_default_construct_n(p, n);
+        return p;
+    }
+
+    void reset();
+
+    size_t used() const { return spilled + offset; }  // bytes no frame
+    size_t capacity() const;
+
+private:
+    struct Block {
+        std::unique_ptr<char[]> data;
+        size_t size;
+    };
+
+    std::vector<Block> blocks;  // o último é o bloco em uso
+    size_t offset = 0;          // próximo byte livre no bloco em uso
+    size_t spilled = 0;         // bytes usados nos blocos anteriores
+
+    void* allocBytes(size_t bytes, size_t align) {
+        size_t p = (offset + align - 1) & ~(align - 1);
+        if (p + bytes > blocks.back().size) return grow(bytes, align);
+        offset = p + bytes;
+        return blocks.back().data.get() + p;
+    }
+    void* grow(size_t bytes, size_t align);
+};
@@ -0,0 +1,85 @@
+#pragma once
+#include <chrono>
+
+// Etapas do frame medidas pelo FrameProfiler (na ordem do laço do app)
+enum class ProfileStage {
+    Clear,    // clear/clearDepth
+    Project,  // BVH/frustum, LOD, projeção e iluminação por vértice
+    Clip,     // culling, montagem/recorte das faces e envio aos tiles
+    Fill,     // rasterização (flush dos tiles / resolve do Deferred)
+    Preview,  // preview da extrusão
+    Lines,    // eixos, gizmo e linhas do modo desenho
+    Hud,      // texto do menu e do perfil
+    Upload,   // GLApp::drawFramebuffer
+    Count
+};
+
+// Tempo por etapa de cada frame, guardado num anel com os últimos HISTORY
+// frames para o overlay mostrar médias e percentis do tempo de frame. O
+// tempo de frame vai de um beginFrame() ao seguinte, então inclui o que não
+// é etapa (eventos, swap/vsync), que aparece como "outros".
+class FrameProfiler {
+public:
+    using clock = std::chrono::steady_clock;
+    static constexpr int STAGES = int(ProfileStage::Count);
+    static constexpr int HISTORY = 256;  // ~4 s a 60 fps
+
+    // fecha o frame anterior (entra no anel) e começa a medir o próximo
+    void beginFrame();
+
+    // soma ms na etapa do frame atual (uma etapa pode ser medida em vários
+    // trechos, p. ex. a projeção de cada objeto)
+    void add(ProfileStage s, double ms) { current.stageMs[int(s)] += float(ms); }
+
+    struct Summary {
+        int frames = 0;              // frames no anel
+        float stageMs[STAGES] = {};  // média por etapa
+        float otherMs = 0.0f;        // média de frame - soma das etapas
+        float p50 = 0.0f, p99 = 0.0f, max = 0.0f;  // tempo de frame
+    };
+    Summary summary() const;
+
+    static const char* stageName(ProfileStage s);
+
+private:
+    struct Sample {
+        float stageMs[STAGES] = {};
+        float frameMs = 0.0f;
+    };
+
+    Sample history[HISTORY];
+    int next = 0;   // próxima posição a escrever no anel
+    int count = 0;  // amostras válidas (até HISTORY)
+
+    Sample current;
+    clock::time_point frameStart;
+    bool started = false;
+};
+
+// Mede o tempo de vida do escopo e soma na etapa; sem profiler (nullptr)
+// não lê o relógio
+class ProfileScope {
+public:
+    ProfileScope(FrameProfiler* profiler, ProfileStage stage)
+        : profiler(profiler), stage(stage) {
+        if (profiler) start = FrameProfiler::clock::now();
+    }
+    ~ProfileScope() { stop(); }
+
+    // encerra a medida antes do fim do escopo
+    void stop() {
+        if (!profiler) return;
+        profiler->add(stage, std::chrono::duration<double, std::milli>(
+                                 FrameProfiler::clock::now() - start)
+                                 .count());
+        profiler = nullptr;
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    FrameProfiler* profiler;
+    ProfileStage stage;
+    FrameProfiler::clock::time_point start;
+};
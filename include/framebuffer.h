@@ -12,7 +12,7 @@ class Framebuffer {
 
     void resize(int w, int h);  // realoca buffers
     void clear(Color c);        // limpa cor
-    void clearDepth(float z);   // limpa depth
+    void clearDepth(float z);   // limpa depth (e a contagem de overdraw)
 
     int width() const { return W; }
     int height() const { return H; }
@@ -21,9 +21,14 @@ class Framebuffer {
     uint32_t& color(int x, int y) { return colorBuf[y * W + x]; }
     float& depth(int x, int y) { return zBuf[y * W + x]; }
 
+    // início da linha y (para kernels que varrem spans)
+    uint32_t* colorRow(int y) { return colorBuf.data() + y * W; }
+    float* depthRow(int y) { return zBuf.data() + y * W; }
+
     // Z-test + escrita (com clip simples)
-    // retorna 1 se escreveu, 0 se não
-    int set(int x, int y, float z, Color c);
+    // retorna 1 se escreveu, 0 se não. Linhas passam countOverdraw = false:
+    // o heatmap mede só o preenchimento de polígonos
+    int set(int x, int y, float z, Color c, bool countOverdraw = true);
 
     int setRaw(int x, int y, Color c) {
         if (x < 0 || y < 0 || x >= W || y >= H) return 0;
@@ -33,14 +38,46 @@ class Framebuffer {
         return 1;
     }
 
+    // ---------------- HI-Z ----------------
+    // Profundidade máxima por bloco em dois níveis (8x8 e 64x64 pixels).
+    // Como o z-test só deixa a profundidade diminuir, um valor antigo ainda
+    // é um limite superior válido: escritas fora do fill_polygon (linhas)
+    // não precisam atualizar nada.
+    static const int HIZ0 = 8;
+    static const int HIZ1 = 64;
+
+    // true se nenhum pixel do retângulo (inclusivo) passaria no z-test
+    // com profundidade >= zmin
+    bool occluded(int x0, int y0, int x1, int y1, float zmin) const;
+
+    // recalcula o Hi-Z dos blocos que tocam o retângulo (após escrever nele)
+    void updateHiZ(int x0, int y0, int x1, int y1);
+
+    // ---------------- OVERDRAW ----------------
+    // Quantas vezes cada pixel de polígono passou no z-test desde o último
+    // clearDepth (heatmap de paint_overdraw). Desligado, overdrawRow() devolve nullptr
+    // e os kernels só pagam esse teste por span.
+    void setOverdrawTracking(bool on);
+    bool overdrawTracking() const { return !overdrawBuf.empty(); }
+    uint16_t* overdrawRow(int y) {
+        return overdrawBuf.empty() ? nullptr : overdrawBuf.data() + y * W;
+    }
+
     // ponteiros crus pra upload (textura)
     uint32_t* colorData() { return colorBuf.data(); }
+    const uint32_t* colorData() const { return colorBuf.data(); }
     float* depthData() { return zBuf.data(); }
 
    private:
     int W, H;
     std::vector<uint32_t> colorBuf;  // RGBA empacotado
     std::vector<float> zBuf;
+    std::vector<uint16_t> overdrawBuf;  // vazio: sem contagem
+
+    int hizW0 = 0, hizH0 = 0;   // blocos do nível 0
+    int hizW1 = 0, hizH1 = 0;   // blocos do nível 1
+    std::vector<float> hiz0;
+    std::vector<float> hiz1;
 
     uint32_t pack(Color c) {
         return (uint32_t(c.a) << 24) | (uint32_t(c.b) << 16) |
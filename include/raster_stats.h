@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdint>
+
+#include "framebuffer.h"
+
+// Contadores de um frame para avaliar culling e early-z. Cada worker dos
+// tiles soma no seu RasterContext (sem atomics) e o SceneRenderer junta tudo
+// depois do flush.
+struct RasterStats {
+    // polígonos (SceneRenderer)
+    uint64_t polygonsSubmitted = 0;  // faces que chegaram à rasterização
+    uint64_t polygonsCulled = 0;     // backface culling
+    uint64_t polygonsClipped = 0;    // recorte não deixou nada na tela
+    // fill_polygon: polígono inteiro descartado pelo Hi-Z (conta uma vez
+    // por tile que o polígono toca)
+    uint64_t hizRejects = 0;
+    // pixels de spans pulados inteiros pelo Hi-Z (sem z-test por pixel, não
+    // entram em depthRejects)
+    uint64_t hizPixels = 0;
+
+    // pixels
+    // cor calculada: halfspace só ilumina quem passa no z-test; spans SIMD
+    // iluminam o grupo de lanes inteiro se alguma passa (grupo todo oculto
+    // não é iluminado); Deferred só o visível no resolve
+    uint64_t pixelsShaded = 0;
+    uint64_t depthPasses = 0;
+    uint64_t depthRejects = 0;
+    uint64_t linePixels = 0;    // plot_line (escritos)
+
+    void add(const RasterStats& o) {
+        polygonsSubmitted += o.polygonsSubmitted;
+        polygonsCulled += o.polygonsCulled;
+        polygonsClipped += o.polygonsClipped;
+        hizRejects += o.hizRejects;
+        hizPixels += o.hizPixels;
+        pixelsShaded += o.pixelsShaded;
+        depthPasses += o.depthPasses;
+        depthRejects += o.depthRejects;
+        linePixels += o.linePixels;
+    }
+};
+
+// Troca a cor de cada pixel pela quantidade de vezes que um polígono passou
+// no z-test nele desde o último clearDepth, sem contar linhas
+// (Framebuffer::setOverdrawTracking):
+// 0 escuro, 1 azul, 2 ciano, 3 verde, 4 amarelo, 5 laranja, 6+ vermelho.
+void paint_overdraw(Framebuffer& fb);
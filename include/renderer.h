@@ -1,11 +1,24 @@
 #pragma once
+#include <algorithm>
+#include <cstdint>
 #include <glm/glm.hpp>
+#include <map>
+#include <memory>
+#include <type_traits>
+#include <utility>
 #include "../include/types.h"
 
 enum class ShadingMode {
     Flat,
     Gouraud,
-    Phong
+    Phong,
+    Deferred  // Phong resolvido uma vez por pixel (visibility buffer)
+};
+
+// Caminho de rasterização usado pelo fill_polygon
+enum class RasterPath {
+    Scanline,   // ET/AET
+    HalfSpace   // edge functions em blocos 8x8 (só polígonos convexos)
 };
 
 struct Light {
@@ -14,21 +27,78 @@ struct Light {
     float intensity = 1.0f;
 };
 
+// Tabelas do modo fast math para uma cor + shininess, montadas uma vez por
+// Renderer::prepareMaterial. Erro contra o caminho exato: especular
+// tabelado < 0.005 (shininess até ~64) e intensidade quantizada em 1/255;
+// medido nos quatro materiais, no máximo 1 unidade por canal.
+struct ShadingTable {
+    static constexpr int SPEC_SIZE = 256;
+
+    Color color;
+    float shininess;
+
+    float spec[SPEC_SIZE + 1];  // pow(i / SPEC_SIZE, shininess)
+    Color shaded[256];          // color * (i / 255), como o modulate()
+
+    // pow(x, shininess) para x em [0, 1], interpolado entre as amostras
+    float specular(float x) const {
+        float f = std::min(x, 1.0f) * SPEC_SIZE;
+        int i = std::min(int(f), SPEC_SIZE - 1);
+        return spec[i] + (spec[i + 1] - spec[i]) * (f - float(i));
+    }
+    Color modulate(float I) const {
+        return shaded[int(std::clamp(I, 0.0f, 1.0f) * 255.0f + 0.5f)];
+    }
+};
+
 class Renderer {
 public:
     Renderer() = default;
 
-    void setLight(const Light& l) { light = l; }
-    void setCameraEye(const glm::vec3& e) { eye = e; }
+    void setLight(const Light& l) {
+        light = l;
+        ++lightVersion;
+    }
+    void setCameraEye(const glm::vec3& e) {
+        if (e != eye) ++lightVersion;
+        eye = e;
+    }
     void setMode(ShadingMode m) { mode = m; }
 
+    const Light& getLight() const { return light; }
+    const glm::vec3& cameraEye() const { return eye; }
+    ShadingMode shadingMode() const { return mode; }
+    // muda sempre que a luz ou o olho mudam (invalida iluminação guardada)
+    uint32_t lightingVersion() const { return lightVersion; }
+    float flatIntensity() const { return flatI; }
+    void setRasterPath(RasterPath r) { raster = r; }
+    RasterPath rasterPath() const { return raster; }
+
     // Flat shading precisa ser pré-calculado
     void setFlatIntensity(float I) { flatI = I; }
 
+    // Fast math: por pixel, especular e cor saem das tabelas do material e
+    // as normalizações usam rsqrt aproximado (ver ShadingTable)
+    void setFastMath(bool on) { fast = on; }
+    bool fastMath() const { return fast; }
+
+    // aponta mat.table para as tabelas da cor/shininess do material,
+    // criando-as na primeira vez; chamar depois de mudar o material e antes
+    // de desenhar com ele (fora do fast math só limpa o ponteiro)
+    void prepareMaterial(Material& mat);
+
+    // tabelas a usar no shading por pixel de mat (nulo: caminho exato)
+    const ShadingTable* fastTable(const Material& mat) const {
+        return fast ? mat.table.get() : nullptr;
+    }
+
     // Calcular intensidade Phong por pixel
     float phong(const glm::vec3& pos,
                 const glm::vec3& normal,
                 const Material& mat) const;
+    // mesma conta com as aproximações do fast math
+    float phongFast(const glm::vec3& pos, const glm::vec3& normal,
+                    const Material& mat, const ShadingTable& table) const;
 
     // usado pelo scanline
     Color shadePixel(const Material& mat,
@@ -36,12 +106,64 @@ public:
                      const glm::vec3& normal, // para Phong
                      const glm::vec3& pos) const;
 
+    // mesmo que shadePixel, mas com o modo fixo em tempo de compilação
+    // (os laços por pixel não testam o modo a cada iteração)
+    template <ShadingMode M>
+    Color shade(const Material& mat, float intensity,
+                const glm::vec3& normal, const glm::vec3& pos) const
+    {
+        if (const ShadingTable* t = fastTable(mat)) {
+            if constexpr (M == ShadingMode::Flat)
+                return t->modulate(flatI);
+            else if constexpr (M == ShadingMode::Gouraud)
+                return t->modulate(intensity);
+            else
+                return t->modulate(phongFast(pos, normal, mat, *t));
+        }
+
+        if constexpr (M == ShadingMode::Flat)
+            return modulate(mat.color, flatI);
+        else if constexpr (M == ShadingMode::Gouraud)
+            return modulate(mat.color, intensity);
+        else
+            return modulate(mat.color, phong(pos, normal, mat));
+    }
+
 private:
     ShadingMode mode = ShadingMode::Flat;
+    RasterPath raster = RasterPath::Scanline;
     Light light;
     glm::vec3 eye = {0,0,5};
+    uint32_t lightVersion = 0;
 
     float flatI = 1.0f; // intensidade FLAT pré-computada
 
+    bool fast = false;
+    // por (cor empacotada, shininess); compartilhadas entre as cópias do
+    // Renderer (uma por tile no flush), endereços estáveis. Uma entrada cuja
+    // única referência é o mapa não tem material vivo e sai na próxima
+    // criação de tabela (ajustes de cor e highlight não acumulam)
+    using TableMap = std::map<std::pair<uint32_t, float>,
+                              std::shared_ptr<ShadingTable>>;
+    std::shared_ptr<TableMap> tables = std::make_shared<TableMap>();
+
     Color modulate(Color c, float I) const;
 };
+
+// Chama f(tag) com tag = std::integral_constant<ShadingMode, M> para o modo
+// atual, escolhendo a instanciação uma vez por desenho. Deferred cai no
+// Phong: fora do visibility buffer os dois iluminam igual.
+template <class F>
+void dispatch_shading(ShadingMode mode, F&& f) {
+    switch (mode) {
+    case ShadingMode::Flat:
+        f(std::integral_constant<ShadingMode, ShadingMode::Flat>());
+        break;
+    case ShadingMode::Gouraud:
+        f(std::integral_constant<ShadingMode, ShadingMode::Gouraud>());
+        break;
+    default:
+        f(std::integral_constant<ShadingMode, ShadingMode::Phong>());
+        break;
+    }
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <vector>
+
+#include "../include/camera.h"
+#include "../include/frame_arena.h"
+#include "../include/frame_profiler.h"
+#include "../include/framebuffer.h"
+#include "../include/raster_stats.h"
+#include "../include/renderer.h"
+#include "../include/shapes.h"
+#include "../include/tile_raster.h"
+#include "../include/visibility_buffer.h"
+
+// Desenho dos sólidos de um frame: BVH + frustum, LOD, projeção por
+// instância, backface culling, recorte, iluminação Flat/Gouraud e
+// rasterização em tiles (ou visibility buffer no Deferred). Guarda os
+// buffers que são reaproveitados entre frames. Não depende de janela: o app
+// e o renderer offline (tools/render_headless.cpp) desenham por aqui.
+class SceneRenderer {
+   public:
+    // começo de um frame: libera os polígonos do frame anterior e zera os
+    // contadores
+    void beginFrame() {
+        arena.reset();
+        frameStats = RasterStats();
+    }
+
+    // todos os shapes visíveis; highlight (se válido) sai com a cor realçada
+    void drawShapes(Shapes& shapes, const FrameTransform& frame,
+                    Renderer& renderer, Framebuffer& fb,
+                    SlotHandle highlight = SlotHandle());
+
+    // poliedro avulso em coordenadas de mundo (preview da extrusão)
+    void drawPolyhedron(const Polyhedron& poly, const FrameTransform& frame,
+                        Renderer& renderer, Framebuffer& fb);
+
+    int threadCount() const { return binner.threadCount(); }
+
+    // drawShapes soma o tempo de projeção, recorte e raster nas etapas do
+    // profiler (nullptr: não mede)
+    void setProfiler(FrameProfiler* p) { profiler = p; }
+
+    // contadores do frame (drawShapes + drawPolyhedron); quem desenha
+    // linhas soma linePixels aqui
+    RasterStats& stats() { return frameStats; }
+
+   private:
+    TileBinner binner;
+    VisibilityBuffer visibility;
+    // vértices projetados do objeto atual (reaproveitado entre objetos)
+    VertexCache vertexCache;
+    // vértices dos polígonos montados/recortados no frame
+    FrameArena arena;
+    // shapes que a BVH devolve para o frustum do frame
+    std::vector<SlotHandle> visibleShapes;
+    FrameProfiler* profiler = nullptr;
+    RasterStats frameStats;
+
+    void begin(const Framebuffer& fb);
+    void flush(Framebuffer& fb, const Renderer& renderer);
+    // ilumina (Flat: a face; Gouraud: vértices ainda INTENSITY_UNLIT) e
+    // manda o polígono para os tiles ou para o visibility buffer
+    void submit(Polygon& poly, Renderer& renderer, Framebuffer& fb);
+};
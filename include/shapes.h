@@ -1,12 +1,59 @@
 #pragma once
+#include <map>
+#include <memory>
+#include <tuple>
 #include <vector>
 #include <glm/glm.hpp>
+#include "bvh.h"
+#include "renderer.h"
+#include "slot_map.h"
 #include "types.h"
+#include "vertex_stream.h"
 
+// Um nível de tesselação de um mesh, em espaço do objeto
+struct MeshLevel {
+    Polyhedron mesh;      // o material daqui não é usado (fica no Shape)
+    VertexStream stream;  // cópia SoA de mesh.verts para os kernels em lote
+    // maior raio projetado (px) em que o erro da tesselação fica abaixo de
+    // LOD_ERROR_PX; infinito no nível 0
+    float maxRadiusPx;
+};
+
+// Geometria imutável em espaço do objeto, compartilhada por todos os Shape
+// criados com os mesmos parâmetros (mil cubos usam um mesh só)
+struct MeshData {
+    // [0] = completo, depois cada vez mais grosso (maxRadiusPx decrescente)
+    std::vector<MeshLevel> levels;
+    Bounds bounds;  // do nível 0
+
+    explicit MeshData(const Polyhedron& p);
+    void addLevel(const Polyhedron& p, float maxRadiusPx);
+};
+
+// erro máximo (px) entre a superfície e a tesselação de um nível
+constexpr float LOD_ERROR_PX = 1.0f;
+// folga relativa na troca de nível, para não alternar a cada frame quando
+// o raio fica perto de um limite
+constexpr float LOD_HYSTERESIS = 0.15f;
+
+// Instância de um MeshData: material e transformação próprios. Transformar
+// só compõe model (O(1)); os vértices passam por ela na projeção
+// (Camera::instanceTransform)
 class Shape {
 public:
-    Polyhedron mesh;
+    std::shared_ptr<const MeshData> data;
+    Material material;
+    glm::mat4 model{1.0f};  // objeto -> mundo
+    // esfera/AABB de mundo (frustum culling, BVH): data->bounds depois de
+    // model, sempre a partir dos bounds de objeto para não inflar a cada
+    // rotação
+    Bounds bounds;
+    // folha em Shapes::bvh (Bvh::NONE fora de um Shapes)
+    int proxy = Bvh::NONE;
+    int lod = 0;  // nível de data->levels em uso
 
+    Shape(std::shared_ptr<const MeshData> data, const Material& material);
+    // mesh próprio, não compartilhado (sólidos extrudados)
     Shape(const Polyhedron& p);
 
     void translate(const glm::vec3& delta);
@@ -16,16 +63,84 @@ public:
     void rotateY(float deg);
     void rotateZ(float deg);
 
+    // centro dos bounds de objeto, em mundo (pivô das rotações)
+    glm::vec3 center() const;
+
+    // atualiza lod para um raio projetado de radiusPx, com histerese
+    int selectLod(float radiusPx);
+    const MeshLevel& level(int k) const { return data->levels[k]; }
+
+    // Gouraud: preenche cache.verts[i].intensity (vértices com outcode 0)
+    // do nível lod, já projetado com a instância deste shape. As
+    // intensidades ficam guardadas entre frames e phong() só roda de novo
+    // quando algo de que ele depende mudou: transformação ou material
+    // (dirty), luz ou olho (Renderer::lightingVersion), projeção do frame
+    // (as posições passadas ao phong são as de tela) ou o nível.
+    void lightVertices(const FrameTransform& frame, const Renderer& renderer,
+                       VertexCache& cache);
+    // depois de mudar ka/kd/ks/shininess de material
+    void invalidateLighting() { lighting.dirty = true; }
+
 private:
+    struct VertexLighting {
+        std::vector<float> intensity;  // por vértice do nível
+        bool dirty = true;
+        int level = -1;
+        uint32_t lightVersion = 0;
+        FrameTransform frame;  // com que foi calculado
+    };
+    VertexLighting lighting;
+
     void applyMatrix(const glm::mat4& M);
 };
 
+// Recalcula mesh.facePlanes a partir das posições (normal de Newell, então
+// vale para faces com mais de 3 vértices). O sentido é escolhido pelas
+// normais dos vértices, não pela ordem dos índices, que não é consistente
+// entre as primitivas.
+void updateFacePlanes(Polyhedron& mesh);
+
+// AABB e esfera justos a partir dos vértices
+Bounds computeBounds(const Polyhedron& mesh);
+
+// bounds de b depois de M (conservador: contém todos os pontos transformados)
+Bounds transformBounds(const Bounds& b, const glm::mat4& M);
+
+// Distância t ao longo do raio até o primeiro triângulo do mesh (faces em
+// leque); false se o raio não acerta antes de tMax. dir não precisa ser
+// unitário (raio levado ao espaço do objeto)
+bool intersectRay(const Polyhedron& mesh, const glm::vec3& origin,
+                  const glm::vec3& dir, float tMax, float& t);
+
 class Shapes {
 public:
-    std::vector<Shape> objects;
+    // handles continuam válidos com inserções/remoções; iteração densa
+    SlotMap<Shape> objects;
+    // índice espacial sobre bounds de objects (id da folha = slot): quem
+    // altera objects (ou transforma um objeto) passa por add/remove/refit
+    // para mantê-lo em dia
+    Bvh bvh;
+
+    SlotHandle add(const Polyhedron& p);
+    SlotHandle add(const Shape& s);
+    void remove(SlotHandle h);
+    // depois de transformar objects[h]
+    void refit(SlotHandle h);
+
+    // objetos que podem aparecer no frustum, em ordem de slot
+    void visible(const FrameTransform& ft, std::vector<SlotHandle>& out) const;
+    // objeto mais próximo sob o raio; handle inválido se nenhum
+    SlotHandle pick(const glm::vec3& origin, const glm::vec3& dir) const;
+
+    SlotHandle createCube(Material material, const glm::vec3& center = {0,0,0}, float size = 2.0f);
+    SlotHandle createPyramid(Material material, const glm::vec3& center, float size, float height);
+    SlotHandle createCylinder(Material material, const glm::vec3& center, float radius, float height, int slices = 16);
+    SlotHandle createSphere(Material material, const glm::vec3& center, float radius, int stacks = 12, int slices = 24);
+
+private:
+    // meshes dos primitivos por (tipo, parâmetros de tesselação), gerados
+    // na primeira vez que são pedidos
+    std::map<std::tuple<ShapeType, int, int>, std::shared_ptr<const MeshData>> meshes;
 
-    Shape& createCube(Material material, const glm::vec3& center = {0,0,0}, float size = 2.0f);
-    Shape& createPyramid(Material material, const glm::vec3& center, float size, float height);
-    Shape& createCylinder(Material material, const glm::vec3& center, float radius, float height, int slices = 16);
-    Shape& createSphere(Material material, const glm::vec3& center, float radius, int stacks = 12, int slices = 24);
+    std::shared_ptr<const MeshData> sharedMesh(ShapeType type, int a = 0, int b = 0);
 };
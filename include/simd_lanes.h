@@ -0,0 +1,111 @@
+#pragma once
+#include <cstdint>
+
+// ------------------------- LANES -------------------------
+// vf = SIMD_LANES floats, vi = SIMD_LANES ints. Os kernels (spans, vértices)
+// são escritos uma vez só em cima destas funções. Sem SSE2/AVX2, SIMD_LANES
+// fica indefinido e cada kernel usa sua versão escalar.
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SIMD_LANES 8
+
+typedef __m256 vf;
+typedef __m256i vi;
+
+static inline vf vset(float a) { return _mm256_set1_ps(a); }
+static inline vf vlane() { return _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7); }
+static inline vf vload(const float* p) { return _mm256_loadu_ps(p); }
+static inline void vstore(float* p, vf a) { _mm256_storeu_ps(p, a); }
+static inline vf vadd(vf a, vf b) { return _mm256_add_ps(a, b); }
+static inline vf vsub(vf a, vf b) { return _mm256_sub_ps(a, b); }
+static inline vf vmul(vf a, vf b) { return _mm256_mul_ps(a, b); }
+static inline vf vdiv(vf a, vf b) { return _mm256_div_ps(a, b); }
+static inline vf vsqrt(vf a) { return _mm256_sqrt_ps(a); }
+static inline vf vrsqrt(vf a) { return _mm256_rsqrt_ps(a); }  // ~12 bits
+static inline vf vmin(vf a, vf b) { return _mm256_min_ps(a, b); }
+static inline vf vmax(vf a, vf b) { return _mm256_max_ps(a, b); }
+static inline vf vand(vf a, vf b) { return _mm256_and_ps(a, b); }
+static inline vf vlt(vf a, vf b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+static inline vf vgt(vf a, vf b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+static inline vf vle(vf a, vf b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+static inline vf vge(vf a, vf b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+static inline vf vsel(vf m, vf a, vf b) { return _mm256_blendv_ps(b, a, m); }
+static inline int vmask(vf m) { return _mm256_movemask_ps(m); }
+
+static inline vi iload(const uint32_t* p) { return _mm256_loadu_si256((const __m256i*)p); }
+static inline void istore(uint32_t* p, vi a) { _mm256_storeu_si256((__m256i*)p, a); }
+static inline vi iset(int a) { return _mm256_set1_epi32(a); }
+static inline vi iadd(vi a, vi b) { return _mm256_add_epi32(a, b); }
+static inline vi isub(vi a, vi b) { return _mm256_sub_epi32(a, b); }
+static inline vi ior(vi a, vi b) { return _mm256_or_si256(a, b); }
+static inline vi iand(vi a, vi b) { return _mm256_and_si256(a, b); }
+template <int N> static inline vi ishl(vi a) { return _mm256_slli_epi32(a, N); }
+template <int N> static inline vi ishr(vi a) { return _mm256_srli_epi32(a, N); }
+static inline vi vtoi(vf a) { return _mm256_cvttps_epi32(a); }
+static inline vf itov(vi a) { return _mm256_cvtepi32_ps(a); }
+static inline vi vasi(vf a) { return _mm256_castps_si256(a); }
+static inline vf iasv(vi a) { return _mm256_castsi256_ps(a); }
+
+// p[idx] por lane (tabelas)
+static inline vf vgather(const float* p, vi idx) { return _mm256_i32gather_ps(p, idx, 4); }
+static inline vi igather(const uint32_t* p, vi idx) {
+    return _mm256_i32gather_epi32((const int*)p, idx, 4);
+}
+
+#elif defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define SIMD_LANES 4
+
+typedef __m128 vf;
+typedef __m128i vi;
+
+static inline vf vset(float a) { return _mm_set1_ps(a); }
+static inline vf vlane() { return _mm_setr_ps(0, 1, 2, 3); }
+static inline vf vload(const float* p) { return _mm_loadu_ps(p); }
+static inline void vstore(float* p, vf a) { _mm_storeu_ps(p, a); }
+static inline vf vadd(vf a, vf b) { return _mm_add_ps(a, b); }
+static inline vf vsub(vf a, vf b) { return _mm_sub_ps(a, b); }
+static inline vf vmul(vf a, vf b) { return _mm_mul_ps(a, b); }
+static inline vf vdiv(vf a, vf b) { return _mm_div_ps(a, b); }
+static inline vf vsqrt(vf a) { return _mm_sqrt_ps(a); }
+static inline vf vrsqrt(vf a) { return _mm_rsqrt_ps(a); }  // ~12 bits
+static inline vf vmin(vf a, vf b) { return _mm_min_ps(a, b); }
+static inline vf vmax(vf a, vf b) { return _mm_max_ps(a, b); }
+static inline vf vand(vf a, vf b) { return _mm_and_ps(a, b); }
+static inline vf vlt(vf a, vf b) { return _mm_cmplt_ps(a, b); }
+static inline vf vgt(vf a, vf b) { return _mm_cmpgt_ps(a, b); }
+static inline vf vle(vf a, vf b) { return _mm_cmple_ps(a, b); }
+static inline vf vge(vf a, vf b) { return _mm_cmpge_ps(a, b); }
+static inline vf vsel(vf m, vf a, vf b) {
+    return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b));
+}
+static inline int vmask(vf m) { return _mm_movemask_ps(m); }
+
+static inline vi iload(const uint32_t* p) { return _mm_loadu_si128((const __m128i*)p); }
+static inline void istore(uint32_t* p, vi a) { _mm_storeu_si128((__m128i*)p, a); }
+static inline vi iset(int a) { return _mm_set1_epi32(a); }
+static inline vi iadd(vi a, vi b) { return _mm_add_epi32(a, b); }
+static inline vi isub(vi a, vi b) { return _mm_sub_epi32(a, b); }
+static inline vi ior(vi a, vi b) { return _mm_or_si128(a, b); }
+static inline vi iand(vi a, vi b) { return _mm_and_si128(a, b); }
+template <int N> static inline vi ishl(vi a) { return _mm_slli_epi32(a, N); }
+template <int N> static inline vi ishr(vi a) { return _mm_srli_epi32(a, N); }
+static inline vi vtoi(vf a) { return _mm_cvttps_epi32(a); }
+static inline vf itov(vi a) { return _mm_cvtepi32_ps(a); }
+static inline vi vasi(vf a) { return _mm_castps_si128(a); }
+static inline vf iasv(vi a) { return _mm_castsi128_ps(a); }
+
+// p[idx] por lane (tabelas); SSE2 não tem gather, vai um a um
+static inline vf vgather(const float* p, vi idx) {
+    alignas(16) int i[4];
+    _mm_store_si128((__m128i*)i, idx);
+    return _mm_setr_ps(p[i[0]], p[i[1]], p[i[2]], p[i[3]]);
+}
+static inline vi igather(const uint32_t* p, vi idx) {
+    alignas(16) int i[4];
+    _mm_store_si128((__m128i*)i, idx);
+    return _mm_setr_epi32(p[i[0]], p[i[1]], p[i[2]], p[i[3]]);
+}
+
+#endif
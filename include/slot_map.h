@@ -0,0 +1,110 @@
+#pragma once
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Referência estável a um item de SlotMap: continua válida (e apontando para
+// o mesmo item) enquanto ele existir, não importa quantos itens entram ou
+// saem. Depois que o item é removido, contains() devolve false; a geração
+// impede que um handle velho acerte o item que reaproveitou o slot.
+struct SlotHandle {
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    uint32_t index = NONE;  // slot
+    uint32_t generation = 0;
+
+    bool operator==(const SlotHandle& o) const {
+        return index == o.index && generation == o.generation;
+    }
+    bool operator!=(const SlotHandle& o) const { return !(*this == o); }
+};
+
+// Pool de itens com inserção e remoção O(1) e itens contíguos para iterar
+// (remover troca o item com o último). Os slots fazem a ponte entre o
+// handle e a posição atual do item no vetor denso.
+template <class T>
+class SlotMap {
+public:
+    SlotHandle insert(const T& value);
+    // false se o handle já não era válido
+    bool remove(SlotHandle h);
+
+    bool contains(SlotHandle h) const {
+        return h.index < slots.size() && slots[h.index].generation == h.generation &&
+               slots[h.index].dense != SlotHandle::NONE;
+    }
+    T& operator[](SlotHandle h) {
+        assert(contains(h));
+        return items[slots[h.index].dense];
+    }
+    const T& operator[](SlotHandle h) const {
+        assert(contains(h));
+        return items[slots[h.index].dense];
+    }
+
+    // handle atual do slot (ids guardados fora, p. ex. na BVH)
+    SlotHandle handleOfSlot(uint32_t slot) const { return {slot, slots[slot].generation}; }
+
+    // posição densa <-> handle (a ordem densa muda quando há remoção)
+    size_t indexOf(SlotHandle h) const { return slots[h.index].dense; }
+    SlotHandle handleAt(size_t i) const { return handleOfSlot(itemSlot[i]); }
+
+    size_t size() const { return items.size(); }
+    bool empty() const { return items.empty(); }
+
+    // iteração densa
+    typename std::vector<T>::iterator begin() { return items.begin(); }
+    typename std::vector<T>::iterator end() { return items.end(); }
+    typename std::vector<T>::const_iterator begin() const { return items.begin(); }
+    typename std::vector<T>::const_iterator end() const { return items.end(); }
+
+private:
+    struct Slot {
+        uint32_t dense = SlotHandle::NONE;  // NONE: slot livre
+        uint32_t generation = 0;            // incrementa a cada remoção
+    };
+
+    std::vector<T> items;           // denso
+    std::vector<uint32_t> itemSlot; // slot de cada item denso
+    std::vector<Slot> slots;
+    std::vector<uint32_t> freeSlots;
+};
+
+template <class T>
+SlotHandle SlotMap<T>::insert(const T& value) {
+    uint32_t s;
+    if (freeSlots.empty()) {
+        s = (uint32_t)slots.size();
+        slots.emplace_back();
+    } else {
+        s = freeSlots.back();
+        freeSlots.pop_back();
+    }
+
+    slots[s].dense = (uint32_t)items.size();
+    items.push_back(value);
+    itemSlot.push_back(s);
+    return {s, slots[s].generation};
+}
+
+template <class T>
+bool SlotMap<T>::remove(SlotHandle h) {
+    if (!contains(h)) return false;
+
+    // o último item ocupa o lugar do removido
+    uint32_t d = slots[h.index].dense;
+    uint32_t last = (uint32_t)items.size() - 1;
+    if (d != last) {
+        items[d] = std::move(items[last]);
+        itemSlot[d] = itemSlot[last];
+        slots[itemSlot[d]].dense = d;
+    }
+    items.pop_back();
+    itemSlot.pop_back();
+
+    slots[h.index].dense = SlotHandle::NONE;
+    slots[h.index].generation++;
+    freeSlots.push_back(h.index);
+    return true;
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <glm/glm.hpp>
+
+#include "../include/framebuffer.h"
+#include "../include/raster_stats.h"
+#include "../include/renderer.h"
+#include "../include/types.h"
+
+// Trecho horizontal de um polígono: atributos no pixel x0 e incremento
+// por pixel em x
+struct Span {
+    int y;
+    int x0, x1;        // inclusivo, já recortado na tela
+
+    float z, dz;
+    float i, di;       // intensidade (Gouraud)
+    glm::vec3 n, dn;   // normal (Phong)
+};
+
+// Z-test + shading de um span inteiro, SIMD_LANES pixels por vez (AVX2: 8,
+// SSE2: 4), escrevendo a cor empacotada direto na linha do framebuffer.
+// Pixels que falham o z-test em todas as lanes nem são iluminados.
+// Retorna quantos pixels foram escritos; stats (opcional) recebe em
+// pixelsShaded os pixels que tiveram a cor calculada (todas as lanes de um
+// grupo em que alguma passou, inclusive as que depois falham o z-test).
+// M escolhe em tempo de compilação quais atributos o kernel lê: Flat só z,
+// Gouraud z e i, Phong z e n. Instanciado para Flat, Gouraud e Phong.
+template <ShadingMode M>
+int shade_span(const Span& s, const Material& mat, const Renderer& renderer,
+               Framebuffer& fb, RasterStats* stats = nullptr);
@@ -0,0 +1,47 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Pool fixo de threads para laços paralelos (um parallelFor por vez).
+class ThreadPool {
+   public:
+    // threads <= 0 usa std::thread::hardware_concurrency()
+    explicit ThreadPool(int threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int size() const { return (int)workers.size(); }
+
+    // executa job(item, worker) para item em [0, count) e bloqueia até o
+    // fim; worker em [0, size()) identifica a thread (para dados locais)
+    template <class F>
+    void parallelFor(int count, F&& job) {
+        // std::function sobre reference_wrapper não aloca, o lambda fica
+        // no frame de quem chamou
+        run(count, std::function<void(int, int)>(std::ref(job)));
+    }
+
+   private:
+    void run(int count, const std::function<void(int, int)>& job);
+    void workerLoop(int worker);
+
+    std::vector<std::thread> workers;
+
+    std::mutex m;
+    std::condition_variable cvWork;
+    std::condition_variable cvDone;
+
+    const std::function<void(int, int)>* job = nullptr;
+    int jobCount = 0;
+    std::atomic<int> nextItem{0};
+    int busy = 0;                 // workers ainda na rodada atual
+    uint64_t generation = 0;      // incrementa a cada parallelFor
+    bool quit = false;
+};
@@ -0,0 +1,57 @@
+#pragma once
+#include <vector>
+
+#include "../include/fill_polygon.h"
+#include "../include/framebuffer.h"
+#include "../include/renderer.h"
+#include "../include/thread_pool.h"
+#include "../include/types.h"
+
+// Rasterização sort-middle: os polígonos já projetados são guardados e
+// distribuídos em tiles de tela pela bbox; no flush cada tile é preenchido
+// por uma thread do pool, que é a única a escrever cor/depth daquele tile.
+class TileBinner {
+   public:
+    static const int TILE = 64;  // lado do tile em pixels (múltiplo de HIZ1)
+
+    explicit TileBinner(int threads = 0) : pool(threads) {}
+
+    // prepara a grade de tiles para uma tela WxH
+    void begin(int w, int h);
+
+    // guarda uma cópia dos vértices (e do material) para o próximo flush;
+    // flatI é a intensidade Flat da face (ignorada nos outros modos)
+    void submit(const Polygon& p, float flatI);
+
+    // rasteriza tudo que foi submetido, na ordem de submissão por tile
+    void flush(Framebuffer& fb, const Renderer& renderer);
+
+    int threadCount() const { return pool.size(); }
+
+    // soma os contadores dos workers desde a última chamada em out e zera
+    // os deles
+    void takeStats(RasterStats& out);
+
+   private:
+    ThreadPool pool;
+
+    int W = 0, H = 0;
+    int tilesX = 0, tilesY = 0;
+
+    // polígonos do frame (capacidade reaproveitada entre frames); os
+    // vértices de todos ficam seguidos em verts a partir de vertStart
+    std::vector<Polygon> polys;
+    std::vector<Vertex2D> verts;
+    std::vector<int> vertStart;
+    std::vector<Material> materials;
+    std::vector<float> flatIs;
+    int count = 0;
+
+    std::vector<std::vector<int>> bins;  // índices de polígono por tile
+    std::vector<RasterContext> contexts; // um por worker
+};
+
+// O Hi-Z grosso é atualizado pela thread do tile sem trava: cada bloco
+// HIZ1 precisa cair inteiro dentro de um único tile
+static_assert(TileBinner::TILE % Framebuffer::HIZ1 == 0,
+              "TileBinner::TILE deve ser múltiplo de Framebuffer::HIZ1");
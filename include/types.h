@@ -1,8 +1,14 @@
 #pragma once
+#include <climits>
+#include <cstddef>
 #include <cstdint>
 #include <glm/vec3.hpp>
+#include <initializer_list>
+#include <memory>
 #include <vector>
 
+#include "slot_map.h"
+
 #define COLOR_BLACK {0,0,0,255}
 #define COLOR_WHITE {255,255,255,255}
 #define COLOR_RED {255,0,0,255}
@@ -24,6 +30,8 @@ struct Color {
     uint8_t r, g, b, a;
 };
 
+struct ShadingTable;
+
 struct Material {
     Color color{255, 255, 255, 255};
 
@@ -31,10 +39,24 @@ struct Material {
     float kd = 0.8f;  // difusa
     float ks = 0.2f;  // especular
     float shininess = 32.0f;
+
+    bool doubleSided = false;  // desenha as duas faces (sem backface culling)
+
+    // tabelas do modo fast math (Renderer::prepareMaterial); nulo fora dele.
+    // Compartilhadas: o Renderer descarta as que nenhum material usa mais
+    std::shared_ptr<const ShadingTable> table = nullptr;
 };
 
+// Índices de uma face: janela sobre Polyhedron::indices (não é dona deles,
+// vale enquanto o poliedro não mudar)
 struct Face {
-    std::vector<int> idx;
+    const int* idx = nullptr;
+    int count = 0;
+
+    int size() const { return count; }
+    int operator[](int i) const { return idx[i]; }
+    const int* begin() const { return idx; }
+    const int* end() const { return idx + count; }
 };
 
 struct Vertex3D {
@@ -50,18 +72,71 @@ struct Vertex2D {
     float intensity;   // GOURAUD
 };
 
+// intensidade ainda não calculada (vértice criado no recorte em clip space)
+constexpr float INTENSITY_UNLIT = -1.0f;
+
 struct Polyhedron {
     std::vector<Vertex3D> verts;
-    std::vector<Face> faces;
+
+    // faces em CSR: os índices de todas ficam seguidos em indices e a face f
+    // ocupa [faceStart[f], faceStart[f + 1]); percorrer as faces em ordem
+    // lê a memória linearmente, sem um vector alocado por face
+    std::vector<int> indices;
+    std::vector<int> faceStart{0};
+
+    int faceCount() const { return (int)faceStart.size() - 1; }
+    Face face(int f) const {
+        return {indices.data() + faceStart[f], faceStart[f + 1] - faceStart[f]};
+    }
+
+    void addFace(const int* idx, int n) {
+        indices.insert(indices.end(), idx, idx + n);
+        faceStart.push_back((int)indices.size());
+    }
+    void addFace(std::initializer_list<int> idx) {
+        addFace(idx.begin(), (int)idx.size());
+    }
+
+    // plano de cada face: xyz = normal para fora, w = -dot(normal, ponto);
+    // usado no backface culling (ver updateFacePlanes)
+    std::vector<glm::vec4> facePlanes;
 
     Material material;
 };
 
+// Volumes envolventes de um objeto em coordenadas de mundo
+struct Bounds {
+    glm::vec3 min{0}, max{0};  // AABB
+    glm::vec3 center{0};       // esfera
+    float radius = 0.0f;
+};
+
+// Janela sobre n elementos contíguos que não pertencem a ela
+template <class T>
+struct ArrayView {
+    T* ptr = nullptr;
+    size_t n = 0;
+
+    size_t size() const { return n; }
+    bool empty() const { return n == 0; }
+    T& operator[](size_t i) const { return ptr[i]; }
+    T* begin() const { return ptr; }
+    T* end() const { return ptr + n; }
+};
+
+// Os vértices moram fora do polígono: no caminho de render vêm da FrameArena
+// do frame, então montar e recortar uma face não aloca
 struct Polygon {
-    std::vector<Vertex2D> verts;  // vertices em ordem
+    ArrayView<Vertex2D> verts;    // vertices em ordem
     Material *material = nullptr; // ponteiro pra material original
 };
 
+// Retângulo em pixels (limites inclusivos); o padrão não recorta nada
+struct ScreenRect {
+    int x0 = 0, y0 = 0;
+    int x1 = INT_MAX, y1 = INT_MAX;
+};
+
 struct Line3D {
     glm::vec3 p1;
     glm::vec3 p2;
@@ -83,7 +158,7 @@ enum class TransformMode { None, Translate, Rotate, Scale };
 
 struct TransformState {
     TransformMode mode = TransformMode::None;
-    int selectedShapeIndex = -1;
+    SlotHandle selectedShape;  // inválido: nenhum
     glm::vec3 originalPosition{0};
     Color originalColor{255, 255, 255, 255};
     float lastAngleX = 0.0f;
@@ -0,0 +1,23 @@
+#pragma once
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "../include/camera.h"
+#include "../include/types.h"
+
+// Posições e normais de um mesh em SoA (um vetor por componente), para os
+// kernels em lote processarem SIMD_LANES vértices por iteração (AVX2: 8,
+// SSE2: 4) com loads contíguos.
+struct VertexStream {
+    std::vector<float> px, py, pz;
+    std::vector<float> nx, ny, nz;
+
+    size_t size() const { return px.size(); }
+
+    void assign(const std::vector<Vertex3D>& verts);  // AoS -> SoA
+};
+
+// view + projeção + viewport de todos os vértices para o cache; mesmo
+// resultado de Camera::clipVertex + toScreen vértice a vértice
+void project_stream(const VertexStream& s, const FrameTransform& ft,
+                    VertexCache& cache);
@@ -0,0 +1,53 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "../include/framebuffer.h"
+#include "../include/raster_stats.h"
+#include "../include/renderer.h"
+#include "../include/types.h"
+
+// Visibility buffer (modo Deferred): a primeira passada só resolve a
+// profundidade e grava, por pixel, o id do triângulo visível; a segunda
+// ilumina cada pixel uma única vez, reconstruindo z e normal pelas
+// baricêntricas do triângulo guardado. O custo do Phong passa a depender
+// da resolução e não de quantas camadas de polígonos se sobrepõem.
+class VisibilityBuffer {
+   public:
+    static constexpr uint32_t NONE = 0xFFFFFFFFu;
+
+    // prepara o buffer de ids para uma tela WxH
+    void begin(int w, int h);
+
+    // triangula o polígono e rasteriza z + id no framebuffer (sem shading)
+    void submit(const Polygon& p, Framebuffer& fb);
+
+    // ilumina os pixels que receberam id desde o último resolve
+    void resolve(Framebuffer& fb, const Renderer& renderer);
+
+    // soma os contadores desde a última chamada em out e zera os daqui
+    void takeStats(RasterStats& out) {
+        out.add(stats);
+        stats = RasterStats();
+    }
+
+   private:
+    struct VisTriangle {
+        Vertex2D v[3];
+        float invArea;  // 1 / área com sinal (baricêntricas no resolve)
+        int material;
+    };
+
+    int W = 0, H = 0;
+    std::vector<uint32_t> ids;        // id do triângulo por pixel
+    std::vector<VisTriangle> tris;    // triângulos do frame
+    std::vector<Material> materials;  // cópia (o highlight é temporário)
+
+    std::vector<int> ring;            // rascunho da triangulação
+    std::vector<int> triIdx;
+
+    // bbox dos pixels com id, para o resolve não varrer a tela toda
+    int dirtyX0 = 0, dirtyY0 = 0, dirtyX1 = -1, dirtyY1 = -1;
+
+    RasterStats stats;
+};
@@ -1,6 +1,6 @@
 #include "../include/bresenham.h"
 
-void plot_line(const Line2D& l, Framebuffer& fb) {
+int plot_line(const Line2D& l, Framebuffer& fb) {
     // definição da reta
     int xi = l.x1;
     int yi = l.y1;
@@ -41,7 +41,7 @@ void plot_line(const Line2D& l, Framebuffer& fb) {
 
     // primeiro ponto: t = 0 → z = zi
     float z = zi;
-    write_pixel_dilated_z(x, y, z, l.color, l.width, fb);
+    int written = write_pixel_dilated_z(x, y, z, l.color, l.width, fb);
 
     int stepIndex = 0; // quantos passos já demos
 
@@ -64,6 +64,7 @@ void plot_line(const Line2D& l, Framebuffer& fb) {
         float t = (stepsTotal > 0) ? (float)stepIndex / (float)stepsTotal : 0.0f;
         z = zi + (zf - zi) * t;
 
-        write_pixel_dilated_z(x, y, z, l.color, l.width, fb);
+        written += write_pixel_dilated_z(x, y, z, l.color, l.width, fb);
     }
+    return written;
 }
@@ -0,0 +1,212 @@
+#include "../include/bvh.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+// folga da caixa gorda: proporcional ao tamanho do objeto, mais um mínimo
+// para objetos pequenos que andam aos poucos (translação seguindo o look)
+glm::vec3 fatMargin(const glm::vec3& min, const glm::vec3& max) {
+    return (max - min) * 0.1f + glm::vec3(0.05f);
+}
+
+// métrica de custo da inserção: área da superfície da caixa
+float area(const glm::vec3& min, const glm::vec3& max) {
+    glm::vec3 d = max - min;
+    return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+}  // namespace
+
+// ------------------------- NÓS -------------------------
+
+int Bvh::allocate() {
+    if (freeList == NONE) {
+        nodes.emplace_back();
+        return int(nodes.size()) - 1;
+    }
+    int n = freeList;
+    freeList = nodes[n].parent;
+    nodes[n] = Node{};
+    return n;
+}
+
+void Bvh::release(int n) {
+    nodes[n].parent = freeList;
+    nodes[n].height = -1;
+    freeList = n;
+}
+
+void Bvh::clear() {
+    nodes.clear();
+    root = NONE;
+    freeList = NONE;
+}
+
+void Bvh::replaceChild(int parent, int oldChild, int newChild) {
+    if (parent == NONE) {
+        root = newChild;
+        return;
+    }
+    Node& p = nodes[parent];
+    p.child[p.child[0] == oldChild ? 0 : 1] = newChild;
+}
+
+void Bvh::refit(int n) {
+    Node& a = nodes[n];
+    const Node& l = nodes[a.child[0]];
+    const Node& r = nodes[a.child[1]];
+    a.min = glm::min(l.min, r.min);
+    a.max = glm::max(l.max, r.max);
+    a.height = 1 + std::max(l.height, r.height);
+}
+
+// ------------------------- API -------------------------
+
+int Bvh::insert(int id, const Bounds& b) {
+    int leaf = allocate();
+    glm::vec3 m = fatMargin(b.min, b.max);
+    nodes[leaf].min = b.min - m;
+    nodes[leaf].max = b.max + m;
+    nodes[leaf].id = id;
+    insertLeaf(leaf);
+    return leaf;
+}
+
+void Bvh::remove(int proxy) {
+    removeLeaf(proxy);
+    release(proxy);
+}
+
+bool Bvh::update(int proxy, const Bounds& b) {
+    Node& n = nodes[proxy];
+    bool inside = true;
+    for (int k = 0; k < 3; k++)
+        inside = inside && n.min[k] <= b.min[k] && b.max[k] <= n.max[k];
+    if (inside) return false;  // ainda dentro da caixa gorda
+
+    removeLeaf(proxy);
+    glm::vec3 m = fatMargin(b.min, b.max);
+    nodes[proxy].min = b.min - m;
+    nodes[proxy].max = b.max + m;
+    insertLeaf(proxy);
+    return true;
+}
+
+// ------------------------- INSERÇÃO / REMOÇÃO -------------------------
+
+void Bvh::insertLeaf(int leaf) {
+    if (root == NONE) {
+        root = leaf;
+        nodes[leaf].parent = NONE;
+        return;
+    }
+
+    // desce pelo filho que menos aumenta a área (heurística de superfície)
+    glm::vec3 lmin = nodes[leaf].min, lmax = nodes[leaf].max;
+    int index = root;
+    while (!nodes[index].leaf()) {
+        const Node& n = nodes[index];
+        float nodeArea = area(n.min, n.max);
+        float combined = area(glm::min(n.min, lmin), glm::max(n.max, lmax));
+
+        // criar um pai novo aqui vs. descer (o custo herdado é o aumento
+        // da caixa deste nó, que todos os ancestrais já pagam)
+        float cost = 2.0f * combined;
+        float inherited = 2.0f * (combined - nodeArea);
+
+        float childCost[2];
+        for (int k = 0; k < 2; k++) {
+            const Node& c = nodes[n.child[k]];
+            float a = area(glm::min(c.min, lmin), glm::max(c.max, lmax));
+            if (!c.leaf()) a -= area(c.min, c.max);
+            childCost[k] = a + inherited;
+        }
+
+        if (cost < childCost[0] && cost < childCost[1]) break;
+        index = n.child[childCost[0] < childCost[1] ? 0 : 1];
+    }
+
+    int sibling = index;
+    int oldParent = nodes[sibling].parent;
+    int newParent = allocate();
+    nodes[newParent].parent = oldParent;
+    nodes[newParent].child[0] = sibling;
+    nodes[newParent].child[1] = leaf;
+    replaceChild(oldParent, sibling, newParent);
+    nodes[sibling].parent = newParent;
+    nodes[leaf].parent = newParent;
+
+    // sobe refazendo caixas/alturas e balanceando
+    for (int i = newParent; i != NONE; i = nodes[i].parent) {
+        i = balance(i);
+        refit(i);
+    }
+}
+
+void Bvh::removeLeaf(int leaf) {
+    if (leaf == root) {
+        root = NONE;
+        return;
+    }
+
+    int parent = nodes[leaf].parent;
+    int grand = nodes[parent].parent;
+    int sibling = nodes[parent].child[nodes[parent].child[0] == leaf ? 1 : 0];
+
+    // o irmão ocupa o lugar do pai
+    replaceChild(grand, parent, sibling);
+    nodes[sibling].parent = grand;
+    release(parent);
+
+    for (int i = grand; i != NONE; i = nodes[i].parent) {
+        i = balance(i);
+        refit(i);
+    }
+}
+
+// Rotação quando as alturas dos filhos de a diferem em mais de 1; devolve a
+// nova raiz da subárvore
+int Bvh::balance(int a) {
+    Node& A = nodes[a];
+    if (A.leaf() || A.height < 2) return a;
+
+    int b = A.child[0], c = A.child[1];
+    int diff = nodes[c].height - nodes[b].height;
+    if (diff >= -1 && diff <= 1) return a;
+
+    // sobe o filho mais alto (up) e o neto mais alto fica com ele; o
+    // outro neto desce para o lugar do filho em a
+    int side = diff > 1 ? 1 : 0;
+    int up = A.child[side];
+    int f = nodes[up].child[0], g = nodes[up].child[1];
+    if (nodes[f].height < nodes[g].height) std::swap(f, g);  // f: mais alto
+
+    nodes[up].child[0] = a;
+    nodes[up].child[1] = f;
+    nodes[up].parent = A.parent;
+    replaceChild(A.parent, a, up);
+    A.parent = up;
+
+    A.child[side] = g;
+    nodes[g].parent = a;
+
+    refit(a);
+    refit(up);
+    return up;
+}
+
+// ------------------------- RAIO -------------------------
+
+bool Bvh::rayBox(const Node& n, const glm::vec3& o, const glm::vec3& inv,
+                 float tMax, float& tEnter) {
+    glm::vec3 t0 = (n.min - o) * inv;
+    glm::vec3 t1 = (n.max - o) * inv;
+    glm::vec3 lo = glm::min(t0, t1), hi = glm::max(t0, t1);
+
+    float tn = std::max(std::max(lo.x, lo.y), std::max(lo.z, 0.0f));
+    float tf = std::min(std::min(hi.x, hi.y), std::min(hi.z, tMax));
+    tEnter = tn;
+    return tn <= tf;
+}
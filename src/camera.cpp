@@ -1,6 +1,10 @@
 #include "../include/camera.h"
+#include "../include/clip_buffers.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <limits>
 
 static void getCameraBasis(const glm::vec3& eye, const glm::vec3& look,
                            const glm::vec3& up, glm::vec3& forward,
@@ -11,77 +15,322 @@ static void getCameraBasis(const glm::vec3& eye, const glm::vec3& look,
         glm::cross(right, forward));  // Y da câmera ortogonalizado
 }
 
-bool Camera::projectVertex(const glm::vec3& pos, const glm::vec3& normal,
-                           Vertex2D& out, int W, int H) const {
-    glm::mat4 V = glm::lookAt(eye, look, up);
-    glm::vec4 p4 = V * glm::vec4(pos, 1);
-    glm::vec3 p = glm::vec3(p4);
-
-    // atrás da câmera → descarta
-    if (p.z > -nearp) return false;
+FrameTransform Camera::frameTransform(int W, int H) const {
+    FrameTransform ft;
+    ft.view = glm::lookAt(eye, look, up);
+    ft.ortho = (type == ProjType::Ortho);
+    ft.nearp = nearp;
+    ft.farp = farp;
+    ft.W = W;
+    ft.H = H;
+    ft.eye = eye;
+    ft.forward = glm::normalize(look - eye);
 
     float aspect = (H > 0) ? float(W) / float(H) : 1.0f;
 
-    float x_ndc, y_ndc;
-
-    if (type == ProjType::Ortho) {
+    if (ft.ortho) {
         float halfH = orthoHeight * 0.5f;
         float halfW = halfH * aspect;
-
-        x_ndc = p.x / halfW;
-        y_ndc = p.y / halfH;
-    } else  // Perspective
-    {
+        ft.sx = 1.0f / halfW;
+        ft.sy = 1.0f / halfH;
+    } else {
         float f = 1.0f / tan(glm::radians(fovY) * 0.5f);
-        float z = -p.z;  // distancia da câmera
+        ft.sx = f / aspect;
+        ft.sy = f;
+    }
+    return ft;
+}
 
-        float k = f / z;  // fator de perspectiva
+// Planos do frustum no espaço de câmera (x, y, z, w): dentro quando
+// dot(xyz, p) + w <= 0. Near, far e os 4 lados, normalizados.
+static int frustumPlanes(const FrameTransform& ft, glm::vec4* pl) {
+    pl[0] = glm::vec4(0, 0, 1, ft.nearp);   // z <= -near
+    pl[1] = glm::vec4(0, 0, -1, -ft.farp);  // z >= -far
+
+    if (ft.ortho) {
+        float hw = 1.0f / ft.sx, hh = 1.0f / ft.sy;
+        pl[2] = glm::vec4(1, 0, 0, -hw);   // x <= halfW
+        pl[3] = glm::vec4(-1, 0, 0, -hw);  // x >= -halfW
+        pl[4] = glm::vec4(0, 1, 0, -hh);
+        pl[5] = glm::vec4(0, -1, 0, -hh);
+    } else {
+        // |x| <= tx * -z, |y| <= ty * -z
+        float tx = 1.0f / ft.sx, ty = 1.0f / ft.sy;
+        float ix = 1.0f / std::sqrt(1.0f + tx * tx);
+        float iy = 1.0f / std::sqrt(1.0f + ty * ty);
+        pl[2] = glm::vec4(ix, 0, tx * ix, 0);
+        pl[3] = glm::vec4(-ix, 0, tx * ix, 0);
+        pl[4] = glm::vec4(0, iy, ty * iy, 0);
+        pl[5] = glm::vec4(0, -iy, ty * iy, 0);
+    }
+    return 6;
+}
 
-        x_ndc = p.x * k / aspect;
-        y_ndc = p.y * k;
+bool Camera::inFrustum(const FrameTransform& ft, const Bounds& b) {
+    glm::vec4 pl[6];
+    int n = frustumPlanes(ft, pl);
+
+    // esfera: a view é rígida, então o raio não muda
+    glm::vec3 c = glm::vec3(ft.view * glm::vec4(b.center, 1.0f));
+    for (int i = 0; i < n; i++) {
+        if (glm::dot(glm::vec3(pl[i]), c) + pl[i].w > b.radius) return false;
     }
 
-    // descarta se muito fora da tela
-    if (x_ndc < -1.5f || x_ndc > 1.5f || y_ndc < -1.5f || y_ndc > 1.5f)
-        return false;
+    // AABB: fora se os 8 cantos estão do lado de fora de um mesmo plano
+    glm::vec3 corner[8];
+    for (int k = 0; k < 8; k++) {
+        glm::vec3 p((k & 1) ? b.max.x : b.min.x, (k & 2) ? b.max.y : b.min.y,
+                    (k & 4) ? b.max.z : b.min.z);
+        corner[k] = glm::vec3(ft.view * glm::vec4(p, 1.0f));
+    }
+    for (int i = 0; i < n; i++) {
+        int out = 0;
+        for (int k = 0; k < 8; k++) {
+            if (glm::dot(glm::vec3(pl[i]), corner[k]) + pl[i].w > 0.0f) out++;
+        }
+        if (out == 8) return false;
+    }
+    return true;
+}
+
+FrameTransform Camera::instanceTransform(const FrameTransform& ft,
+                                         const glm::mat4& model) {
+    FrameTransform it = ft;
+    it.view = ft.view * model;
+
+    // plano e ponto levados juntos para o objeto: o sinal de
+    // dot(plano, eye) e de dot(normal, forward) não muda
+    glm::mat4 inv = glm::inverse(model);
+    it.eye = glm::vec3(inv * glm::vec4(ft.eye, 1.0f));
+    it.forward = glm::mat3(inv) * ft.forward;
+    it.normalMatrix = glm::transpose(glm::mat3(inv));
+    return it;
+}
+
+float Camera::screenRadius(const FrameTransform& ft, const Bounds& b) {
+    float w = 1.0f;
+    if (!ft.ortho) {
+        w = -(ft.view * glm::vec4(b.center, 1.0f)).z;
+        if (w <= ft.nearp) return std::numeric_limits<float>::infinity();
+    }
+    return b.radius * ft.sy * 0.5f * float(ft.H) / w;
+}
+
+// ------------------------- VÉRTICES -------------------------
+
+uint8_t Camera::clipVertex(const FrameTransform& ft, const glm::vec3& pos,
+                           ClipVertex& out) {
+    glm::vec4 p = ft.view * glm::vec4(pos, 1);
+
+    out.x = p.x * ft.sx;
+    out.y = p.y * ft.sy;
+    out.d = -p.z;  // distancia da câmera
+    out.w = ft.ortho ? 1.0f : out.d;
+
+    float g = GUARD_BAND * out.w;
+    uint8_t code = 0;
+    if (out.d < ft.nearp) code |= CLIP_NEAR;  // atrás da câmera
+    if (out.d > ft.farp) code |= CLIP_FAR;
+    if (out.x < -g) code |= CLIP_LEFT;
+    if (out.x > g) code |= CLIP_RIGHT;
+    if (out.y < -g) code |= CLIP_BOTTOM;
+    if (out.y > g) code |= CLIP_TOP;
+    return code;
+}
+
+void Camera::toScreen(const FrameTransform& ft, const ClipVertex& c,
+                      Vertex2D& out) {
+    float x_ndc = c.x / c.w;
+    float y_ndc = c.y / c.w;
 
     // converte para pixel
-    out.x = (int)((x_ndc * 0.5f + 0.5f) * W);
-    out.y = (int)((1.0f - (y_ndc * 0.5f + 0.5f)) * H);
+    out.x = (int)((x_ndc * 0.5f + 0.5f) * ft.W);
+    out.y = (int)((1.0f - (y_ndc * 0.5f + 0.5f)) * ft.H);
+    out.z = c.d;
+}
+
+bool Camera::projectVertex(const FrameTransform& ft, const glm::vec3& pos,
+                           const glm::vec3& normal, Vertex2D& out) {
+    ClipVertex c;
+    if (clipVertex(ft, pos, c) != 0) return false;
 
-    out.z = -p.z;
+    toScreen(ft, c, out);
     out.normal = normal;
     out.intensity = 1.0f;
-
     return true;
 }
 
+bool Camera::projectVertex(const glm::vec3& pos, const glm::vec3& normal,
+                           Vertex2D& out, int W, int H) const {
+    return projectVertex(frameTransform(W, H), pos, normal, out);
+}
+
+// projeta v na posição i do cache (já dimensionado)
+static void cacheVertex(const FrameTransform& ft, const Vertex3D& v,
+                        VertexCache& cache, size_t i) {
+    Vertex2D& o = cache.verts[i];
+    cache.outcode[i] = Camera::clipVertex(ft, v.position, cache.clip[i]);
+    if (cache.outcode[i] == 0) Camera::toScreen(ft, cache.clip[i], o);
+    o.normal = ft.normalMatrix * v.normal;
+    o.intensity = 1.0f;
+}
+
+void Camera::projectVerts(const FrameTransform& ft, const Polyhedron& obj,
+                          VertexCache& cache) {
+    size_t n = obj.verts.size();
+    cache.verts.resize(n);
+    cache.clip.resize(n);
+    cache.outcode.resize(n);
+
+    for (size_t i = 0; i < n; i++) cacheVertex(ft, obj.verts[i], cache, i);
+}
+
+// ------------------------- RECORTE EM CLIP SPACE -------------------------
+
+namespace {
+
+struct ClipVert {
+    ClipVertex c;
+    glm::vec3 normal;
+};
+
+// distância com sinal ao plano (>= 0: dentro)
+float planeDist(const FrameTransform& ft, const ClipVertex& c, int plane) {
+    float g = GUARD_BAND * c.w;
+    switch (plane) {
+        case CLIP_NEAR: return c.d - ft.nearp;
+        case CLIP_FAR: return ft.farp - c.d;
+        case CLIP_LEFT: return c.x + g;
+        case CLIP_RIGHT: return g - c.x;
+        case CLIP_BOTTOM: return c.y + g;
+        default: return g - c.y;  // CLIP_TOP
+    }
+}
+
+// Sutherland-Hodgman contra um plano; out precisa de 2n posições
+int clipPlane(const FrameTransform& ft, const ClipVert* in, int n,
+              ClipVert* out, int plane) {
+    int m = 0;
+    const ClipVert* s = &in[n - 1];
+    float ds = planeDist(ft, s->c, plane);
+
+    for (int i = 0; i < n; i++) {
+        const ClipVert* p = &in[i];
+        float dp = planeDist(ft, p->c, plane);
+
+        if ((ds >= 0.0f) != (dp >= 0.0f)) {
+            // interpolação linear em clip space (antes da divisão por w)
+            float t = ds / (ds - dp);
+            ClipVert& r = out[m++];
+            r.c.x = s->c.x + (p->c.x - s->c.x) * t;
+            r.c.y = s->c.y + (p->c.y - s->c.y) * t;
+            r.c.d = s->c.d + (p->c.d - s->c.d) * t;
+            r.c.w = s->c.w + (p->c.w - s->c.w) * t;
+            r.normal = s->normal + (p->normal - s->normal) * t;
+        }
+        if (dp >= 0.0f) out[m++] = *p;
+
+        s = p;
+        ds = dp;
+    }
+    return m;
+}
+
+}  // namespace
+
+Polygon Camera::assembleAndClip(const FrameTransform& ft,
+                                const Polyhedron& obj, const Face& face,
+                                const VertexCache& cache,
+                                FrameArena& arena) {
+    uint8_t any = 0, all = 0xFF;
+    for (int id : face) {
+        any |= cache.outcode[id];
+        all &= cache.outcode[id];
+    }
+
+    // todos os vértices fora de um mesmo plano: nada visível
+    if (face.size() < 3 || all != 0) return Polygon();
+
+    Polygon poly;
+    poly.material = (Material*)&obj.material;
+
+    if (any == 0) {
+        // caso comum: face inteira dentro do guard band
+        poly.verts.ptr = arena.alloc<Vertex2D>(face.size());
+        for (int id : face) poly.verts[poly.verts.n++] = cache.verts[id];
+    } else {
+        // só os planos que algum vértice cruza; buffers na pilha
+        int n = face.size();
+        ClipBuffers<ClipVert> buf;
+        buf.reserve(n);
+
+        for (int i = 0; i < n; i++) {
+            int id = face[i];
+            buf.in[i].c = cache.clip[id];
+            buf.in[i].normal = cache.verts[id].normal;
+        }
+
+        for (int plane = CLIP_NEAR; plane <= CLIP_TOP && n > 0; plane <<= 1) {
+            if (!(any & plane)) continue;
+            buf.reserve(n);
+            n = clipPlane(ft, buf.in, n, buf.out, plane);
+            buf.swap();
+        }
+        if (n < 3) return Polygon();
+
+        poly.verts.ptr = arena.alloc<Vertex2D>(n);
+        poly.verts.n = n;
+        for (int i = 0; i < n; i++) {
+            toScreen(ft, buf.in[i].c, poly.verts[i]);
+            poly.verts[i].normal = buf.in[i].normal;
+            poly.verts[i].intensity = INTENSITY_UNLIT;
+        }
+    }
+
+    clipPolygon2DInPlace(poly, ft.W, ft.H, arena);
+    return poly;
+}
+
 Polygon Camera::projectFace(const Polyhedron& obj, const Face& face, int W,
-                            int H) const {
+                            int H, FrameArena& arena) const {
+    FrameTransform ft = frameTransform(W, H);
+
     Polygon poly;
     poly.material = (Material*)&obj.material;
+    poly.verts.ptr = arena.alloc<Vertex2D>(face.size());
 
-    for (int id : face.idx) {
+    for (int id : face) {
         const auto& v = obj.verts[id];
-        Vertex2D v2;
 
-        if (!projectVertex(v.position, v.normal, v2, W, H)) {
-            poly.verts.clear();
+        if (!projectVertex(ft, v.position, v.normal, poly.verts[poly.verts.n])) {
+            poly.verts.n = 0;
             return poly;
         }
 
-        poly.verts.push_back(v2);
+        poly.verts.n++;
     }
 
     return poly;
 }
 
 Polygon Camera::projectAndClip(const Polyhedron& obj, const Face& face, int W,
-                               int H) const {
-    Polygon poly = projectFace(obj, face, W, H);
-    if (poly.verts.size() < 3) return Polygon();
-
-    return clipPolygon2D(poly, W, H);
+                               int H, FrameArena& arena) const {
+    FrameTransform ft = frameTransform(W, H);
+
+    // só os vértices da face, renumerados 0..n-1; o cache é por thread e
+    // não realoca depois de aquecido
+    static thread_local VertexCache cache;
+    int n = face.size();
+    cache.verts.resize(n);
+    cache.clip.resize(n);
+    cache.outcode.resize(n);
+
+    int* local = arena.alloc<int>(n);
+    for (int i = 0; i < n; i++) {
+        cacheVertex(ft, obj.verts[face[i]], cache, i);
+        local[i] = i;
+    }
+    return assembleAndClip(ft, obj, Face{local, n}, cache, arena);
 }
 
 void Camera::updateFromOrbitAngles() {
@@ -107,6 +356,14 @@ void Camera::updateFromOrbitAngles() {
     up = glm::normalize(glm::cross(right, forward));
 }
 
+void Camera::setOrbit(float azimuthDeg, float elevationDeg, float distance) {
+    azimuth = 0.0f;
+    elevation = 0.0f;
+    orbitDistance = std::max(distance, 0.1f);
+    addElevation(elevationDeg);
+    addAzimuth(azimuthDeg);  // normaliza para [-180, 180]
+}
+
 void Camera::addAzimuth(float deltaDeg) {
     azimuth += deltaDeg;
     if (azimuth > 180.0f) azimuth -= 360.0f;
@@ -1,4 +1,5 @@
 #include "../include/crop_sutherland_hodgman.h"
+#include "../include/clip_buffers.h"
 
 #include <algorithm>
 #include <cmath>
@@ -75,10 +76,11 @@ static V2f intersectEdge(const V2f& s, const V2f& p, float A, char edge) {
     return interp(s, p, t);
 }
 
-static std::vector<V2f> clipAgainstEdge(const std::vector<V2f>& in, float A,
-                                        char edge) {
-    std::vector<V2f> out;
-    if (in.empty()) return out;
+// out precisa de espaço para 2n vértices
+static int clipAgainstEdge(const V2f* in, int n, V2f* out, float A,
+                           char edge) {
+    int m = 0;
+    if (n == 0) return 0;
 
     auto inside = [&](const V2f& p) {
         switch (edge) {
@@ -94,24 +96,25 @@ static std::vector<V2f> clipAgainstEdge(const std::vector<V2f>& in, float A,
         return false;
     };
 
-    V2f S = in.back();
+    V2f S = in[n - 1];
     bool S_in = inside(S);
 
-    for (const V2f& P : in) {
+    for (int i = 0; i < n; i++) {
+        const V2f& P = in[i];
         bool P_in = inside(P);
 
         if (P_in && S_in) {
             // caso 1: S in → P in
-            out.push_back(P);
+            out[m++] = P;
 
         } else if (P_in && !S_in) {
             // caso 2: S out → P in
-            out.push_back(intersectEdge(S, P, A, edge));
-            out.push_back(P);
+            out[m++] = intersectEdge(S, P, A, edge);
+            out[m++] = P;
 
         } else if (!P_in && S_in) {
             // caso 4: S in → P out
-            out.push_back(intersectEdge(S, P, A, edge));
+            out[m++] = intersectEdge(S, P, A, edge);
 
         } else {
             // caso 3: S out → P out
@@ -120,41 +123,57 @@ static std::vector<V2f> clipAgainstEdge(const std::vector<V2f>& in, float A,
         S = P;
         S_in = P_in;
     }
-    return out;
+    return m;
 }
 
 
-Polygon clipPolygon2D(const Polygon& in, int W, int H) {
-    Polygon out;
-    out.material = in.material;
+void clipPolygon2DInPlace(Polygon& poly, int W, int H, FrameArena& arena) {
+    int n = (int)poly.verts.size();
+    if (n < 3) {
+        poly.verts.n = 0;
+        return;
+    }
 
-    if (in.verts.size() < 3) return out;
+    // bbox dentro da tela: nada a recortar
+    int bx0 = poly.verts[0].x, bx1 = bx0;
+    int by0 = poly.verts[0].y, by1 = by0;
+    for (const auto& v : poly.verts) {
+        bx0 = std::min(bx0, v.x);
+        bx1 = std::max(bx1, v.x);
+        by0 = std::min(by0, v.y);
+        by1 = std::max(by1, v.y);
+    }
+    if (bx0 >= 0 && by0 >= 0 && bx1 <= W - 1 && by1 <= H - 1) return;
 
     float xmin = 0.0f;
     float xmax = (float)(W - 1);
     float ymin = 0.0f;
     float ymax = (float)(H - 1);
 
-    // converte para floats
-    std::vector<V2f> poly;
-    poly.reserve(in.verts.size());
-    for (const auto& v : in.verts) poly.push_back(toV2f(v));
-
-    poly = clipAgainstEdge(poly, xmin, 'L');
-    if (poly.empty()) return out;
+    ClipBuffers<V2f> buf;
+    buf.reserve(n);
 
-    poly = clipAgainstEdge(poly, xmax, 'R');
-    if (poly.empty()) return out;
-
-    poly = clipAgainstEdge(poly, ymin, 'T');
-    if (poly.empty()) return out;
-
-    poly = clipAgainstEdge(poly, ymax, 'B');
-    if (poly.empty()) return out;
+    // converte para floats
+    for (int i = 0; i < n; i++) buf.in[i] = toV2f(poly.verts[i]);
+
+    const float edgeA[4] = {xmin, xmax, ymin, ymax};
+    const char edgeId[4] = {'L', 'R', 'T', 'B'};
+    for (int e = 0; e < 4 && n > 0; e++) {
+        buf.reserve(n);
+        n = clipAgainstEdge(buf.in, n, buf.out, edgeA[e], edgeId[e]);
+        buf.swap();
+    }
 
     // converte de volta para Vertex2D
-    out.verts.reserve(poly.size());
-    for (const auto& v : poly) out.verts.push_back(toV2d(v));
+    if ((size_t)n > poly.verts.size()) poly.verts.ptr = arena.alloc<Vertex2D>(n);
+    poly.verts.n = n;
+    for (int i = 0; i < n; i++) poly.verts[i] = toV2d(buf.in[i]);
+}
 
+Polygon clipPolygon2D(const Polygon& in, int W, int H, FrameArena& arena) {
+    Polygon out = in;
+    out.verts.ptr = arena.alloc<Vertex2D>(in.verts.size());
+    std::copy(in.verts.begin(), in.verts.end(), out.verts.begin());
+    clipPolygon2DInPlace(out, W, H, arena);
     return out;
 }
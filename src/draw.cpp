@@ -16,13 +16,16 @@ void write_pixel_dilated(int x, int y, Color color, int width,
     }
 }
 
-void write_pixel_dilated_z(int x, int y, float z, Color c, int width,
-                           Framebuffer& fb) {
+int write_pixel_dilated_z(int x, int y, float z, Color c, int width,
+                          Framebuffer& fb) {
     int half = width / 2;
+    int written = 0;
 
     for (int dy = -half; dy <= half; ++dy) {
         for (int dx = -half; dx <= half; ++dx) {
-            fb.set(x + dx, y + dy, z, c); 
+            // linhas ficam fora do heatmap de overdraw
+            written += fb.set(x + dx, y + dy, z, c, false);
         }
     }
+    return written;
 }
@@ -1,5 +1,6 @@
 #include "../include/extrusion.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdio>
 #include <glm/gtc/matrix_transform.hpp>
@@ -61,8 +62,22 @@ Polyhedron createExtrudedPolyhedron(const std::vector<glm::vec3>& basePolygon,
         extrudeDirection = glm::vec3(1, 0, 0);
     }
 
+    // Base orientada com a normal contra a extrusão (para fora do sólido),
+    // seja qual for o sentido em que o usuário desenhou o polígono. Com isso
+    // todas as faces saem com a mesma orientação (ver backface culling).
+    std::vector<glm::vec3> base = basePolygon;
+    {
+        glm::vec3 n(0);
+        for (int i = 0; i < numVertices; ++i) {
+            n += glm::cross(base[i], base[(i + 1) % numVertices]);
+        }
+        if (glm::dot(n, extrudeDirection) * depth > 0.0f) {
+            std::reverse(base.begin(), base.end());
+        }
+    }
+
     // Cria os vértices do topo
-    std::vector<glm::vec3> topPolygon = basePolygon;
+    std::vector<glm::vec3> topPolygon = base;
     for (auto& vertex : topPolygon) {
         vertex += extrudeDirection * depth;
     }
@@ -78,7 +93,7 @@ Polyhedron createExtrudedPolyhedron(const std::vector<glm::vec3>& basePolygon,
 
     // Preenche vértices da base (índices 0 a N-1)
     for (int i = 0; i < numVertices; ++i) {
-        poly.verts[i].position = basePolygon[i];
+        poly.verts[i].position = base[i];
     }
 
     // Preenche vértices do topo (índices N a 2N-1)
@@ -86,32 +101,23 @@ Polyhedron createExtrudedPolyhedron(const std::vector<glm::vec3>& basePolygon,
         poly.verts[numVertices + i].position = topPolygon[i];
     }
 
-    // Função auxiliar para adicionar face
-    auto addFace = [&](const std::vector<int>& indices) {
-        Face f;
-        f.idx = indices;
-        poly.faces.push_back(f);
-    };
+    // base + topo (N índices cada) e N quads laterais
+    poly.indices.reserve(numVertices * 6);
+    poly.faceStart.reserve(numVertices + 3);
+
+    std::vector<int> cap(numVertices);
 
     // Face da base (mantém a ordem original)
-    {
-        std::vector<int> indices;
-        indices.reserve(numVertices);
-        for (int i = 0; i < numVertices; ++i) {
-            indices.push_back(i);
-        }
-        addFace(indices);
+    for (int i = 0; i < numVertices; ++i) {
+        cap[i] = i;
     }
+    poly.addFace(cap.data(), numVertices);
 
     // Face do topo (inverte a ordem para normal apontar para fora)
-    {
-        std::vector<int> indices;
-        indices.reserve(numVertices);
-        for (int i = 0; i < numVertices; ++i) {
-            indices.push_back(numVertices + (numVertices - 1 - i));
-        }
-        addFace(indices);
+    for (int i = 0; i < numVertices; ++i) {
+        cap[i] = numVertices + (numVertices - 1 - i);
     }
+    poly.addFace(cap.data(), numVertices);
 
     // Faces laterais (quads)
     for (int i = 0; i < numVertices; ++i) {
@@ -121,22 +127,23 @@ Polyhedron createExtrudedPolyhedron(const std::vector<glm::vec3>& basePolygon,
         int topIdx0 = numVertices + i;
         int topIdx1 = numVertices + nextI;
 
-        // Cria quad
-        addFace({baseIdx0, baseIdx1, topIdx1, topIdx0});
+        // Cria quad (mesmo sentido da base e do topo)
+        poly.addFace({baseIdx0, topIdx0, topIdx1, baseIdx1});
     }
 
     // Calcula normais por face e acumula nos vértices
-    for (const auto& face : poly.faces) {
-        if (face.idx.size() < 3) continue;
+    for (int f = 0; f < poly.faceCount(); ++f) {
+        Face face = poly.face(f);
+        if (face.size() < 3) continue;
 
-        glm::vec3 p0 = poly.verts[face.idx[0]].position;
-        glm::vec3 p1 = poly.verts[face.idx[1]].position;
-        glm::vec3 p2 = poly.verts[face.idx[2]].position;
+        glm::vec3 p0 = poly.verts[face[0]].position;
+        glm::vec3 p1 = poly.verts[face[1]].position;
+        glm::vec3 p2 = poly.verts[face[2]].position;
 
         glm::vec3 normal = glm::normalize(glm::cross(p1 - p0, p2 - p0));
 
         // Acumula normal em todos os vértices da face
-        for (int vertexIdx : face.idx) {
+        for (int vertexIdx : face) {
             poly.verts[vertexIdx].normal += normal;
         }
     }
@@ -151,6 +158,7 @@ Polyhedron createExtrudedPolyhedron(const std::vector<glm::vec3>& basePolygon,
         }
     }
 
+    updateFacePlanes(poly);
     return poly;
 }
 
@@ -161,7 +169,7 @@ void buildExtrudedSolid(const std::vector<glm::vec3>& basePolygon,
         createExtrudedPolyhedron(basePolygon, plane, depth, material);
     if (poly.verts.empty()) return;
 
-    shapes.objects.emplace_back(poly);
+    shapes.add(poly);
 }
 
 void updateExtrusionPreview(ExtrusionState& state, double mouseX, double mouseY,
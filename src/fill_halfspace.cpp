@@ -0,0 +1,94 @@
+#include "../include/fill_halfspace.h"
+
+// ------------------------- TRIANGLE -------------------------
+
+// só interpola o que o modo M usa (Flat: z; Gouraud: z, i; Phong: z, n)
+template <ShadingMode M>
+static void fill_triangle(const Vertex2D& a, const Vertex2D& b,
+                          const Vertex2D& c, const Material& mat,
+                          Framebuffer& fb, const Renderer& renderer,
+                          const ScreenRect& clip, RasterStats* stats)
+{
+    int covered = 0, written = 0;
+    halfspace_traverse(a, b, c, fb.width(), fb.height(), clip,
+                       [&](int x, int y, float la, float lb, float lc) {
+        covered++;
+        // z-test antes de iluminar, como no scanline: oculto não paga Phong
+        float z = la * a.z + lb * b.z + lc * c.z;
+        if (!(z < fb.depth(x, y))) return;
+
+        float I = 0.0f;
+        glm::vec3 n(0.0f);
+        if constexpr (M == ShadingMode::Gouraud)
+            I = la * a.intensity + lb * b.intensity + lc * c.intensity;
+        if constexpr (M == ShadingMode::Phong)
+            n = a.normal * la + b.normal * lb + c.normal * lc;
+
+        Color col = renderer.shade<M>(mat, I, n, glm::vec3(x, y, z));
+        written += write_pixel_z(x, y, z, col, fb);
+    });
+
+    if (stats) {
+        stats->pixelsShaded += written;
+        stats->depthPasses += written;
+        stats->depthRejects += covered - written;
+    }
+}
+
+void fill_triangle_halfspace(const Vertex2D& a, const Vertex2D& b,
+                             const Vertex2D& c, const Material& mat,
+                             Framebuffer& fb, Renderer& renderer,
+                             const ScreenRect& clip, RasterStats* stats)
+{
+    dispatch_shading(renderer.shadingMode(), [&](auto mode) {
+        fill_triangle<decltype(mode)::value>(a, b, c, mat, fb, renderer, clip,
+                                             stats);
+    });
+}
+
+// ------------------------- POLYGON (LEQUE) -------------------------
+
+bool fill_polygon_halfspace(const Polygon& p, Framebuffer& fb,
+                            Renderer& renderer, const ScreenRect& clip,
+                            RasterStats* stats)
+{
+    size_t N = p.verts.size();
+    if (N < 3 || !p.material) return true;  // nada a desenhar
+
+    // leque só é válido para polígonos convexos (extrusões podem não ser).
+    // Curvas todas para o mesmo lado não bastam: um pentagrama também passa,
+    // dando duas voltas. Num convexo simples o sentido em x das arestas
+    // troca no máximo duas vezes (uma ida e uma volta).
+    int sign = 0;
+    int firstDx = 0, lastDx = 0, flips = 0;
+    for (size_t i = 0; i < N; i++) {
+        const Vertex2D& a = p.verts[i];
+        const Vertex2D& b = p.verts[(i + 1) % N];
+        const Vertex2D& c = p.verts[(i + 2) % N];
+
+        int dx = (b.x > a.x) - (b.x < a.x);
+        if (dx != 0) {
+            if (firstDx == 0) firstDx = dx;
+            else if (dx != lastDx) flips++;
+            lastDx = dx;
+        }
+
+        int cr = (b.x - a.x) * (c.y - b.y) - (b.y - a.y) * (c.x - b.x);
+        if (cr == 0) continue;
+
+        int s = (cr > 0) ? 1 : -1;
+        if (sign == 0) sign = s;
+        else if (s != sign) return false;
+    }
+    if (lastDx != firstDx) flips++;  // fecha o ciclo
+    if (flips > 2) return false;
+
+    dispatch_shading(renderer.shadingMode(), [&](auto mode) {
+        for (size_t i = 1; i + 1 < N; i++) {
+            fill_triangle<decltype(mode)::value>(p.verts[0], p.verts[i],
+                                                 p.verts[i + 1], *p.material,
+                                                 fb, renderer, clip, stats);
+        }
+    });
+    return true;
+}
@@ -1,10 +1,10 @@
 #include "../include/fill_polygon.h"
+#include "../include/fill_halfspace.h"
+#include "../include/span_shading.h"
 
-#include <list>
 #include <algorithm>
 #include <iostream>
 
-using std::list;
 using std::vector;
 
 // ------------------------- SCANLINE HELPERS -------------------------
@@ -42,34 +42,36 @@ int compare_frac(const frac& a, const frac& b) {
 }
 
 
-struct node_z {
-    int ymax;
-    frac xmin;
-    frac m_inv;
-
-    float z_min;
-    float dz_dy;
-
-    float i_min;      // intensidade por vértice (Gouraud)
-    float di_dy;
-
-    glm::vec3 n_min;  // normal na aresta (Phong)
-    glm::vec3 dn_dy;
-};
+// ordenação por inserção estável: a AET quase não muda de ordem entre
+// scanlines, então isso fica O(n) na prática e não aloca nada
+static void sort_aet(vector<node_z>& aet) {
+    for (size_t i = 1; i < aet.size(); i++) {
+        node_z e = aet[i];
+        size_t j = i;
+        while (j > 0 && compare_frac(aet[j - 1].xmin, e.xmin) > 0) {
+            aet[j] = aet[j - 1];
+            --j;
+        }
+        aet[j] = e;
+    }
+}
 
 
-// ------------------------- FILL POLYGON -------------------------
+// ------------------------- SCANLINE -------------------------
 
-void fill_polygon(const Polygon& p,
-                  Framebuffer& fb,
-                  Renderer& renderer)
+// ET/AET especializado por modo: só os atributos que o modo usa são
+// interpolados nas arestas e nos spans (Flat: z; Gouraud: z, i; Phong: z, n)
+template <ShadingMode M>
+static void fill_scanline(const Polygon& p, Framebuffer& fb,
+                          const Renderer& renderer, RasterContext& ctx)
 {
-    if (p.verts.size() < 3) return;
-    if (!p.material) return;
-
     int H = fb.height();
-    vector<list<node_z>> et(H);
-    list<node_z> aet;
+    vector<node_z>& edges = ctx.edges;
+    vector<node_z>& et = ctx.et;
+    vector<node_z>& aet = ctx.aet;
+
+    edges.clear();
+    aet.clear();
 
     int min_y = H;
     int max_y = 0;
@@ -89,62 +91,81 @@ void fill_polygon(const Polygon& p,
         int x0 = v0.x, x1 = v1.x;
         float z0 = v0.z, z1 = v1.z;
 
-        float I0 = v0.intensity;
-        float I1 = v1.intensity;
-
-        glm::vec3 n0 = v0.normal;
-        glm::vec3 n1 = v1.normal;
-
         // sort so y0 < y1
+        const Vertex2D& lo = (y0 < y1) ? v0 : v1;
+        const Vertex2D& hi = (y0 < y1) ? v1 : v0;
         if (y0 > y1) {
             std::swap(y0, y1);
             std::swap(x0, x1);
             std::swap(z0, z1);
-            std::swap(I0, I1);
-            std::swap(n0, n1);
         }
 
         nd.xmin = {x0, 1};
+        nd.ymin = y0;
         nd.ymax = y1;
         nd.m_inv = {x1 - x0, y1 - y0};
 
         nd.z_min = z0;
         nd.dz_dy = (z1 - z0) / float(y1 - y0);
 
-        nd.i_min = I0;
-        nd.di_dy = (I1 - I0) / float(y1 - y0);
-
-        nd.n_min = n0;
-        nd.dn_dy = (n1 - n0) / float(y1 - y0);
+        if constexpr (M == ShadingMode::Gouraud) {
+            nd.i_min = lo.intensity;
+            nd.di_dy = (hi.intensity - lo.intensity) / float(y1 - y0);
+        }
+        if constexpr (M == ShadingMode::Phong) {
+            nd.n_min = lo.normal;
+            nd.dn_dy = (hi.normal - lo.normal) / float(y1 - y0);
+        }
 
         min_y = std::min(min_y, y0);
         max_y = std::max(max_y, y1);
 
         if (y0 >= 0 && y0 < H)
-            et[y0].push_back(nd);
+            edges.push_back(nd);
     }
 
     min_y = std::max(min_y, 0);
     max_y = std::min(max_y, H - 1);
 
+    if (edges.empty() || min_y > max_y) return;
+
+    // recorte (tiles): linhas acima de clip_y0 só avançam a AET
+    int clip_x0 = std::max(ctx.clip.x0, 0);
+    int clip_x1 = std::min(ctx.clip.x1, fb.width() - 1);
+    int clip_y0 = std::max(ctx.clip.y0, 0);
+    int clip_y1 = std::min(ctx.clip.y1, H - 1);
+
+    // ET em memória contígua: counting sort estável por ymin, com baldes
+    // só na faixa [min_y, max_y] do polígono (não na altura da tela toda)
+    vector<int>& start = ctx.etStart;
+    start.assign(max_y - min_y + 2, 0);
+    for (const auto& e : edges) start[e.ymin - min_y + 1]++;
+    for (size_t k = 1; k < start.size(); k++) start[k] += start[k - 1];
+
+    et.resize(edges.size());
+    for (const auto& e : edges) et[start[e.ymin - min_y]++] = e;
+
+    size_t next = 0; // próxima aresta da ET a entrar na AET
+
     // ------------------------ SCANLINE ------------------------
-    for (int y = min_y; y <= max_y; y++) {
+    for (int y = min_y; y <= std::min(max_y, clip_y1); y++) {
 
         // Add edges starting at this scanline
-        for (const auto& e : et[y]) {
+        for (; next < et.size() && et[next].ymin == y; ++next) {
+            const node_z& e = et[next];
             auto it = aet.begin();
             while (it != aet.end() && compare_frac(it->xmin, e.xmin) < 0) ++it;
             aet.insert(it, e);
         }
 
         // Remove edges reaching ymax
-        for (auto it = aet.begin(); it != aet.end();) {
-            if (it->ymax == y) it = aet.erase(it);
-            else ++it;
+        size_t kept = 0;
+        for (size_t k = 0; k < aet.size(); k++) {
+            if (aet[k].ymax != y) aet[kept++] = aet[k];
         }
+        aet.resize(kept);
 
         if (aet.empty()) continue;
-
         // --------- PAIR THE INTERSECTIONS (span fill) ---------
         bool inside = false;
         int last_x = 0;
@@ -155,48 +176,55 @@ void fill_polygon(const Polygon& p,
         for (auto& e : aet) {
             int x_curr = inside ? floor_frac(e.xmin) : ceil_frac(e.xmin);
 
-            if (inside) {
+            if (inside && y >= clip_y0) {
                 int x0 = last_x, x1 = x_curr;
                 if (x0 > x1) std::swap(x0, x1);
 
                 float z0 = last_z, z1 = e.z_min;
                 float dz = (x1 != x0) ? (z1 - z0) / float(x1 - x0) : 0.0f;
 
-                float I0 = last_I, I1 = e.i_min;
-                float dI = (x1 != x0) ? (I1 - I0) / float(x1 - x0) : 0.0f;
-
-                glm::vec3 n0 = last_N, n1 = e.n_min;
-                glm::vec3 dn = (x1 != x0) ? (n1 - n0) / float(x1 - x0) : glm::vec3(0);
-
-                // ---- PIXEL LOOP ----
-                float zz = z0;
-                float II = I0;
-                glm::vec3 nn = n0;
-
-                for (int x = x0; x <= x1; x++) {
-
-                    // posição aproximada em screen-space
-                    glm::vec3 pos(x, y, zz);
-
-                    Color c = renderer.shadePixel(
-                        *p.material,
-                        II,
-                        nn,
-                        pos
-                    );
-
-                    write_pixel_z(x, y, zz, c, fb);
+                // ---- SPAN (kernel SIMD) ----
+                Span s;
+                s.y = y;
+                s.x0 = std::max(x0, clip_x0);
+                s.x1 = std::min(x1, clip_x1);
+
+                float skip = float(s.x0 - x0);
+                s.z = z0 + dz * skip;
+                s.dz = dz;
+
+                if constexpr (M == ShadingMode::Gouraud) {
+                    float I0 = last_I, I1 = e.i_min;
+                    float dI = (x1 != x0) ? (I1 - I0) / float(x1 - x0) : 0.0f;
+                    s.i = I0 + dI * skip;
+                    s.di = dI;
+                }
+                if constexpr (M == ShadingMode::Phong) {
+                    glm::vec3 n0 = last_N, n1 = e.n_min;
+                    glm::vec3 dn = (x1 != x0) ? (n1 - n0) / float(x1 - x0) : glm::vec3(0);
+                    s.n = n0 + dn * skip;
+                    s.dn = dn;
+                }
 
-                    zz += dz;
-                    II += dI;
-                    nn += dn;
+                // span inteiro atrás do Hi-Z: pula sem iluminar
+                float zend = s.z + s.dz * float(s.x1 - s.x0);
+                if (s.x0 <= s.x1) {
+                    int len = s.x1 - s.x0 + 1;
+                    if (fb.occluded(s.x0, y, s.x1, y, std::min(s.z, zend))) {
+                        ctx.stats.hizPixels += len;
+                    } else {
+                        int written = shade_span<M>(s, *p.material, renderer,
+                                                    fb, &ctx.stats);
+                        ctx.stats.depthPasses += written;
+                        ctx.stats.depthRejects += len - written;
+                    }
                 }
             }
 
             last_x = x_curr;
             last_z = e.z_min;
-            last_I = e.i_min;
-            last_N = e.n_min;
+            if constexpr (M == ShadingMode::Gouraud) last_I = e.i_min;
+            if constexpr (M == ShadingMode::Phong) last_N = e.n_min;
             inside = !inside;
         }
 
@@ -204,12 +232,67 @@ void fill_polygon(const Polygon& p,
         for (auto& e : aet) {
             e.xmin = add_frac(e.xmin, e.m_inv);
             e.z_min += e.dz_dy;
-            e.i_min += e.di_dy;
-            e.n_min += e.dn_dy;
+            if constexpr (M == ShadingMode::Gouraud) e.i_min += e.di_dy;
+            if constexpr (M == ShadingMode::Phong) e.n_min += e.dn_dy;
         }
 
-        aet.sort([](const node_z& a, const node_z& b) {
-            return compare_frac(a.xmin, b.xmin) < 0;
-        });
+        sort_aet(aet);
+    }
+}
+
+
+// ------------------------- FILL POLYGON -------------------------
+
+void fill_polygon(const Polygon& p,
+                  Framebuffer& fb,
+                  Renderer& renderer)
+{
+    static thread_local RasterContext ctx;
+    fill_polygon(p, fb, renderer, ctx);
+}
+
+void fill_polygon(const Polygon& p,
+                  Framebuffer& fb,
+                  Renderer& renderer,
+                  RasterContext& ctx)
+{
+    if (p.verts.size() < 3) return;
+    if (!p.material) return;
+
+    // bbox (já recortada) e menor z: se o Hi-Z diz que tudo ali está mais
+    // perto, o polígono inteiro cai aqui sem montar ET nem iluminar nada
+    int bx0 = p.verts[0].x, bx1 = bx0;
+    int by0 = p.verts[0].y, by1 = by0;
+    float zmin = p.verts[0].z;
+    for (const auto& v : p.verts) {
+        bx0 = std::min(bx0, v.x);
+        bx1 = std::max(bx1, v.x);
+        by0 = std::min(by0, v.y);
+        by1 = std::max(by1, v.y);
+        zmin = std::min(zmin, v.z);
+    }
+    bx0 = std::max(bx0, ctx.clip.x0);
+    by0 = std::max(by0, ctx.clip.y0);
+    bx1 = std::min(bx1, ctx.clip.x1);
+    by1 = std::min(by1, ctx.clip.y1);
+
+    if (fb.occluded(bx0, by0, bx1, by1, zmin)) {
+        ctx.stats.hizRejects++;
+        return;
+    }
+
+    // caminho alternativo: edge functions (cai no scanline se não convexo)
+    if (renderer.rasterPath() == RasterPath::HalfSpace &&
+        fill_polygon_halfspace(p, fb, renderer, ctx.clip, &ctx.stats)) {
+        fb.updateHiZ(bx0, by0, bx1, by1);
+        return;
     }
+
+    // o modo é resolvido aqui, uma vez por polígono
+    dispatch_shading(renderer.shadingMode(), [&](auto mode) {
+        fill_scanline<decltype(mode)::value>(p, fb, renderer, ctx);
+    });
+
+    fb.updateHiZ(bx0, by0, bx1, by1);
 }
+
@@ -0,0 +1,33 @@
+#include "../include/frame_arena.h"
+
+#include <algorithm>
+
+FrameArena::FrameArena(size_t initialBytes) {
+    size_t size = std::max<size_t>(initialBytes, 1024);
+    blocks.push_back({std::unique_ptr<char[]>(new char[size]), size});
+}
+
+void* FrameArena::grow(size_t bytes, size_t align) {
+    // bloco novo pelo menos dobrando: poucos blocos até o frame estabilizar
+    spilled += offset;
+    size_t size = std::max(bytes + align, blocks.back().size * 2);
+    blocks.push_back({std::unique_ptr<char[]>(new char[size]), size});
+    offset = 0;
+    return allocBytes(bytes, align);
+}
+
+void FrameArena::reset() {
+    if (blocks.size() > 1) {
+        size_t total = capacity();
+        blocks.clear();
+        blocks.push_back({std::unique_ptr<char[]>(new char[total]), total});
+    }
+    offset = 0;
+    spilled = 0;
+}
+
+size_t FrameArena::capacity() const {
+    size_t total = 0;
+    for (const auto& b : blocks) total += b.size;
+    return total;
+}
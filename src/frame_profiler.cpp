@@ -0,0 +1,65 @@
+#include "../include/frame_profiler.h"
+
+#include <algorithm>
+
+void FrameProfiler::beginFrame() {
+    clock::time_point now = clock::now();
+    if (started) {
+        current.frameMs =
+            std::chrono::duration<float, std::milli>(now - frameStart).count();
+        history[next] = current;
+        next = (next + 1) % HISTORY;
+        count = std::min(count + 1, HISTORY);
+    }
+    current = Sample();
+    frameStart = now;
+    started = true;
+}
+
+FrameProfiler::Summary FrameProfiler::summary() const {
+    Summary s;
+    s.frames = count;
+    if (count == 0) return s;
+
+    float frames[HISTORY];
+    float frameSum = 0.0f;
+    for (int i = 0; i < count; i++) {
+        const Sample& sample = history[i];
+        for (int k = 0; k < STAGES; k++) s.stageMs[k] += sample.stageMs[k];
+        frames[i] = sample.frameMs;
+        frameSum += sample.frameMs;
+    }
+
+    float stageSum = 0.0f;
+    for (int k = 0; k < STAGES; k++) {
+        s.stageMs[k] /= count;
+        stageSum += s.stageMs[k];
+    }
+    s.otherMs = std::max(0.0f, frameSum / count - stageSum);
+
+    // percentil pelo posto mais próximo
+    auto rank = [&](float p) {
+        int k = std::min(count - 1, int(p * count));
+        std::nth_element(frames, frames + k, frames + count);
+        return frames[k];
+    };
+    s.p50 = rank(0.50f);
+    s.p99 = rank(0.99f);
+    s.max = *std::max_element(frames, frames + count);
+    return s;
+}
+
+const char* FrameProfiler::stageName(ProfileStage s) {
+    switch (s) {
+        case ProfileStage::Clear: return "CLEAR";
+        case ProfileStage::Project: return "PROJECAO";
+        case ProfileStage::Clip: return "RECORTE";
+        case ProfileStage::Fill: return "RASTER";
+        case ProfileStage::Preview: return "PREVIEW";
+        case ProfileStage::Lines: return "LINHAS";
+        case ProfileStage::Hud: return "HUD";
+        case ProfileStage::Upload: return "UPLOAD";
+        case ProfileStage::Count: break;
+    }
+    return "";
+}
@@ -1,9 +1,25 @@
 #include "../include/framebuffer.h"
 
+#include <algorithm>
+
 void Framebuffer::resize(int w, int h) {
     W = w; H = h;
     colorBuf.assign(W * H, 0); // preto transparente por padrão
     zBuf.assign(W * H, std::numeric_limits<float>::infinity());
+
+    hizW0 = (W + HIZ0 - 1) / HIZ0;
+    hizH0 = (H + HIZ0 - 1) / HIZ0;
+    hizW1 = (W + HIZ1 - 1) / HIZ1;
+    hizH1 = (H + HIZ1 - 1) / HIZ1;
+    hiz0.assign(hizW0 * hizH0, std::numeric_limits<float>::infinity());
+    hiz1.assign(hizW1 * hizH1, std::numeric_limits<float>::infinity());
+    if (!overdrawBuf.empty()) overdrawBuf.assign(W * H, 0);
+}
+
+void Framebuffer::setOverdrawTracking(bool on) {
+    if (on == overdrawTracking()) return;
+    if (on) overdrawBuf.assign(W * H, 0);
+    else std::vector<uint16_t>().swap(overdrawBuf);
 }
 
 void Framebuffer::clear(Color c) {
@@ -13,9 +29,12 @@ void Framebuffer::clear(Color c) {
 
 void Framebuffer::clearDepth(float z) {
     for (int i = 0; i < W*H; i++) zBuf[i] = z;
+    std::fill(hiz0.begin(), hiz0.end(), z);
+    std::fill(hiz1.begin(), hiz1.end(), z);
+    std::fill(overdrawBuf.begin(), overdrawBuf.end(), 0);
 }
 
-int Framebuffer::set(int x, int y, float z, Color c) {
+int Framebuffer::set(int x, int y, float z, Color c, bool countOverdraw) {
     // clip simples na tela
     if (x < 0 || y < 0 || x >= W || y >= H) return 0;
 
@@ -23,7 +42,76 @@ int Framebuffer::set(int x, int y, float z, Color c) {
     if (z < zBuf[i]) {
         zBuf[i] = z;
         colorBuf[i] = pack(c);
+        if (countOverdraw && !overdrawBuf.empty()) overdrawBuf[i]++;
         return 1;
     }
     return 0;
 }
+
+bool Framebuffer::occluded(int x0, int y0, int x1, int y1, float zmin) const {
+    x0 = std::max(x0, 0);
+    y0 = std::max(y0, 0);
+    x1 = std::min(x1, W - 1);
+    y1 = std::min(y1, H - 1);
+    if (x0 > x1 || y0 > y1) return true;  // fora da tela
+
+    const int R = HIZ1 / HIZ0;
+
+    for (int ty = y0 / HIZ1; ty <= y1 / HIZ1; ty++) {
+        for (int tx = x0 / HIZ1; tx <= x1 / HIZ1; tx++) {
+            // nível 1: um compare resolve o bloco 64x64 inteiro
+            if (zmin >= hiz1[ty * hizW1 + tx]) continue;
+
+            // nível 1 não decide: olha os blocos 8x8 dentro do retângulo
+            int bx0 = std::max(x0 / HIZ0, tx * R);
+            int bx1 = std::min(x1 / HIZ0, tx * R + R - 1);
+            int by0 = std::max(y0 / HIZ0, ty * R);
+            int by1 = std::min(y1 / HIZ0, ty * R + R - 1);
+
+            for (int by = by0; by <= by1; by++)
+                for (int bx = bx0; bx <= bx1; bx++)
+                    if (zmin < hiz0[by * hizW0 + bx]) return false;
+        }
+    }
+    return true;
+}
+
+void Framebuffer::updateHiZ(int x0, int y0, int x1, int y1) {
+    x0 = std::max(x0, 0);
+    y0 = std::max(y0, 0);
+    x1 = std::min(x1, W - 1);
+    y1 = std::min(y1, H - 1);
+    if (x0 > x1 || y0 > y1) return;
+
+    // nível 0: máximo dos pixels de cada bloco 8x8 tocado
+    for (int by = y0 / HIZ0; by <= y1 / HIZ0; by++) {
+        int py1 = std::min(by * HIZ0 + HIZ0, H);
+        for (int bx = x0 / HIZ0; bx <= x1 / HIZ0; bx++) {
+            int px0 = bx * HIZ0;
+            int px1 = std::min(px0 + HIZ0, W);
+
+            float m = -std::numeric_limits<float>::infinity();
+            for (int py = by * HIZ0; py < py1; py++) {
+                const float* row = &zBuf[py * W];
+                for (int px = px0; px < px1; px++) m = std::max(m, row[px]);
+            }
+            hiz0[by * hizW0 + bx] = m;
+        }
+    }
+
+    // nível 1: máximo dos blocos 8x8 de cada bloco 64x64 tocado
+    const int R = HIZ1 / HIZ0;
+    for (int ty = y0 / HIZ1; ty <= y1 / HIZ1; ty++) {
+        int by1 = std::min(ty * R + R, hizH0);
+        for (int tx = x0 / HIZ1; tx <= x1 / HIZ1; tx++) {
+            int bx0 = tx * R;
+            int bx1 = std::min(bx0 + R, hizW0);
+
+            float m = -std::numeric_limits<float>::infinity();
+            for (int by = ty * R; by < by1; by++)
+                for (int bx = bx0; bx < bx1; bx++)
+                    m = std::max(m, hiz0[by * hizW0 + bx]);
+            hiz1[ty * hizW1 + tx] = m;
+        }
+    }
+}
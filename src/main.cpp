@@ -11,20 +11,24 @@
 #include "../include/extrusion.h"
 #include "../include/fill_polygon.h"
 #include "../include/font8x8.h"
+#include "../include/frame_profiler.h"
 #include "../include/framebuffer.h"
 #include "../include/gl_app.h"
 #include "../include/lines.h"
 #include "../include/renderer.h"
+#include "../include/scene_renderer.h"
 #include "../include/shapes.h"
 #include "../include/types.h"
 #include "../include/menu.h"
+#include "../include/raster_stats.h"
 
-static void drawLine3D(const Line3D& l3, const Camera& camera, Framebuffer& fb,
-                       int W, int H) {
+// retorna os pixels escritos (contador de linhas do F3)
+static int drawLine3D(const Line3D& l3, const Camera& camera, Framebuffer& fb,
+                      int W, int H) {
     Line2D l2;
-    if (!camera.projectLine(l3, l2, W, H)) return;
-    if (!clipLineCohenSutherland(l2, 0, 0, W - 1, H - 1)) return;
-    plot_line(l2, fb);
+    if (!camera.projectLine(l3, l2, W, H)) return 0;
+    if (!clipLineCohenSutherland(l2, 0, 0, W - 1, H - 1)) return 0;
+    return plot_line(l2, fb);
 }
 
 // ================== MAIN ==================
@@ -48,6 +52,14 @@ int main() {
     Camera camera;
     // Configurar Renderer (iluminação e shading)
     Renderer renderer;
+    // Desenho dos sólidos (tiles em paralelo, uma thread por núcleo)
+    SceneRenderer scene;
+    // tempo por etapa do frame (overlay com F3)
+    FrameProfiler profiler;
+    bool showProfiler = false;
+    // mapa de overdraw (F4): conta os z-tests aprovados por pixel
+    bool showOverdraw = false;
+    scene.setProfiler(&profiler);
 
     Material material = MATERIAL_RUBBER;
 
@@ -91,6 +103,19 @@ int main() {
     app.setKeyCallback([&](int key, int, int action, int) {
         if (action != GLFW_PRESS && action != GLFW_REPEAT) return;
 
+        // vale em qualquer menu
+        if (key == GLFW_KEY_F3) {
+            if (action == GLFW_PRESS) showProfiler = !showProfiler;
+            return;
+        }
+        if (key == GLFW_KEY_F4) {
+            if (action == GLFW_PRESS) {
+                showOverdraw = !showOverdraw;
+                fb.setOverdrawTracking(showOverdraw);
+            }
+            return;
+        }
+
         key_press(key,menu_type,shape_type,camera,material,currentMode,renderer,extrusionState,shapes,transformState);
     });
 
@@ -112,27 +137,23 @@ int main() {
         // Rotação no modo Transform - girar em torno do centro do objeto
         if (menu_type == MenuType::Transform && 
             transformState.mode == TransformMode::Rotate &&
-            transformState.selectedShapeIndex >= 0 && 
-            transformState.selectedShapeIndex < (int)shapes.objects.size()) {
+            shapes.objects.contains(transformState.selectedShape)) {
             
             float rotSensitivity = 0.5f;
             float angleY = dx * rotSensitivity;
             float angleX = -dy * rotSensitivity;
             
-            auto& selectedShape = shapes.objects[transformState.selectedShapeIndex];
+            auto& selectedShape = shapes.objects[transformState.selectedShape];
             
-            // Calcular centro do objeto
-            glm::vec3 center(0);
-            for (const auto& vert : selectedShape.mesh.verts) {
-                center += vert.position;
-            }
-            center /= float(selectedShape.mesh.verts.size());
+            // Centro do objeto (só compõe o model, sem tocar nos vértices)
+            glm::vec3 center = selectedShape.center();
             
             // Transladar para origem, rotacionar, e transladar de volta
             selectedShape.translate(-center);
             selectedShape.rotateY(angleY);
             selectedShape.rotateX(angleX);
             selectedShape.translate(center);
+            shapes.refit(transformState.selectedShape);
         }
     });
 
@@ -157,6 +178,21 @@ int main() {
                           << extrusionState.polygon3D.size() << " total)\n";
             }
         }
+        // Transform: clique seleciona o shape sob o cursor (raio na BVH)
+        if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_PRESS &&
+            menu_type == MenuType::Transform) {
+            int w, h;
+            glfwGetFramebufferSize(app.window(), &w, &h);
+            glm::vec3 dir = screenToWorldRay(mouseX, mouseY, w, h, camera);
+            SlotHandle hit = shapes.pick(camera.eye, dir);
+            if (shapes.objects.contains(hit)) {
+                transformState.selectedShape = hit;
+                std::cout << "Shape selecionado: "
+                          << (shapes.objects.indexOf(hit) + 1) << "/"
+                          << shapes.objects.size() << "\n";
+            }
+            return;
+        }
         if(button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_PRESS && extrusionState.mode != EditMode::Draw){
             switch (shape_type){
                 case ShapeType::Cube:
@@ -177,6 +213,7 @@ int main() {
     });
 
     while (!glfwWindowShouldClose(app.window())) {
+        profiler.beginFrame();
         double currentTime = glfwGetTime();
         framesThisSecond++;
 
@@ -195,89 +232,55 @@ int main() {
         }
 
         // limpar buffers
-        fb.clear({30, 30, 40, 255});
-        fb.clearDepth(1000.0f);
+        {
+            ProfileScope timer(&profiler, ProfileStage::Clear);
+            scene.beginFrame();
+            fb.clear({30, 30, 40, 255});
+            fb.clearDepth(1000.0f);
+        }
 
         // atualizar posição da câmera no renderer (para Phong)
         renderer.setCameraEye(camera.eye);
 
+        // view/projeção do frame, montadas uma vez só
+        FrameTransform frame = camera.frameTransform(w, h);
+
         // atualizar preview do ponto no plano de desenho
         if (extrusionState.mode != EditMode::None) {
+            ProfileScope timer(&profiler, ProfileStage::Preview);
             updateExtrusionPreview(extrusionState, mouseX, mouseY, w, h,
                                    camera);
         }
         
         // Atualizar translação no modo Transform
         if (menu_type == MenuType::Transform && 
-            transformState.selectedShapeIndex >= 0 && 
-            transformState.selectedShapeIndex < (int)shapes.objects.size()) {
+            shapes.objects.contains(transformState.selectedShape)) {
             
             if (transformState.mode == TransformMode::Translate) {
                 // Calcular a posição atual do centro do shape
-                glm::vec3 currentCenter(0);
-                auto& selectedShape = shapes.objects[transformState.selectedShapeIndex];
-                for (const auto& vert : selectedShape.mesh.verts) {
-                    currentCenter += vert.position;
-                }
-                currentCenter /= float(selectedShape.mesh.verts.size());
+                auto& selectedShape = shapes.objects[transformState.selectedShape];
+                glm::vec3 currentCenter = selectedShape.center();
                 
                 // Transladar para acompanhar o look da câmera
                 glm::vec3 delta = camera.look - currentCenter;
-                selectedShape.translate(delta);
-            }
-        }
-
-        // desenhar sólidos
-        for (int i = 0; i < (int)shapes.objects.size(); ++i) {
-            auto& s = shapes.objects[i];
-            
-            // Salvar material original
-            Material originalMaterial = s.mesh.material;
-            
-            // Aplicar highlight no shape selecionado (amarelo/laranja brilhante)
-            bool isSelected = (menu_type == MenuType::Transform && i == transformState.selectedShapeIndex);
-            if (isSelected) {
-                // Misturar cor original com amarelo forte para highlight visível
-                s.mesh.material.color.r = std::min(255, (int)s.mesh.material.color.r + 150);
-                s.mesh.material.color.g = std::min(255, (int)s.mesh.material.color.g + 150);
-                s.mesh.material.color.b = std::max(0, (int)s.mesh.material.color.b - 50); // Reduzir azul para dar tom amarelado
-            }
-            for (const auto& face : s.mesh.faces) {
-                Polygon poly2D = camera.projectAndClip(s.mesh, face, w, h);
-
-                if (poly2D.verts.size() >= 3) {
-                    if (currentMode == ShadingMode::Flat) {
-                        glm::vec3 faceCenter(0);
-                        glm::vec3 faceNormal(0);
-                        for (const auto& v : poly2D.verts) {
-                            faceCenter += glm::vec3(v.x, v.y, v.z);
-                            faceNormal += v.normal;
-                        }
-                        faceCenter /= float(poly2D.verts.size());
-                        faceNormal = glm::normalize(faceNormal);
-
-                        float intensity = renderer.phong(faceCenter, faceNormal,
-                                                         *poly2D.material);
-                        renderer.setFlatIntensity(intensity);
-
-                    } else if (currentMode == ShadingMode::Gouraud) {
-                        for (auto& v : poly2D.verts) {
-                            glm::vec3 pos3D(v.x, v.y, v.z);
-                            v.intensity = renderer.phong(pos3D, v.normal,
-                                                         *poly2D.material);
-                        }
-                    }
-
-                    fill_polygon(poly2D, fb, renderer);
+                // parado: não mexe no model (acumularia arredondamento) nem
+                // invalida o cache de iluminação
+                if (glm::dot(delta, delta) > 1e-8f) {
+                    selectedShape.translate(delta);
+                    shapes.refit(transformState.selectedShape);
                 }
             }
-            
-            // Restaurar material original após desenho
-            if (isSelected) {
-                s.mesh.material = originalMaterial;
-            }
         }
 
+        // desenhar sólidos; no modo Transform o selecionado sai realçado
+        scene.drawShapes(shapes, frame, renderer, fb,
+                         menu_type == MenuType::Transform
+                             ? transformState.selectedShape
+                             : SlotHandle());
+
+        // eixos, gizmo e linhas do modo desenho
+        ProfileScope linesTimer(&profiler, ProfileStage::Lines);
+
         // desenha as linhas dos eixos globais
         for (const auto& l3 : lines.objects) {
             Line2D l2;
@@ -286,7 +289,7 @@ int main() {
 
             if (!clipLineCohenSutherland(l2, 0, 0, w - 1, h - 1)) continue;
 
-            plot_line(l2, fb);
+            scene.stats().linePixels += plot_line(l2, fb);
         }
 
         // gizmo do look (só desenha no modo Orbit, não no FPS)
@@ -295,8 +298,7 @@ int main() {
             
             // No modo Transform, o gizmo está na posição do look (que já foi movido pelo TAB)
             if (menu_type == MenuType::Transform && 
-                transformState.selectedShapeIndex >= 0 && 
-                transformState.selectedShapeIndex < (int)shapes.objects.size()) {
+                shapes.objects.contains(transformState.selectedShape)) {
                 // O gizmo usa o camera.look que já foi atualizado quando pressionou TAB
                 gizmoPosition = camera.look;
             }
@@ -317,7 +319,7 @@ int main() {
                 Line2D l2;
                 if (camera.projectLine(worldLine, l2, w, h)) {
                     l2.width = gizmoWidth;
-                    plot_line(l2, fb);
+                    scene.stats().linePixels += plot_line(l2, fb);
                 }
             }
         }
@@ -331,7 +333,7 @@ int main() {
                              extrusionState.polygon3D[i],
                              {255, 255, 0, 255},
                              2};
-                    drawLine3D(l, camera, fb, w, h);
+                    scene.stats().linePixels += drawLine3D(l, camera, fb, w, h);
                 }
 
                 // Linha de preview do último vértice até o mouse
@@ -340,17 +342,22 @@ int main() {
                              extrusionState.previewPoint,
                              {255, 255, 255, 255},
                              2};
-                    drawLine3D(l, camera, fb, w, h);
+                    scene.stats().linePixels += drawLine3D(l, camera, fb, w, h);
                 }
             }
         }
 
+        linesTimer.stop();
+
         // renderizar preview da extrusão como poliedro sólido
         if (extrusionState.mode == EditMode::Extrude &&
             extrusionState.polygon3D.size() >= 3) {
+            ProfileScope timer(&profiler, ProfileStage::Preview);
+
             // Cria material cyan para preview
             Material previewMat = material;
             previewMat.color = {50, 200, 200, 255};  // Cyan
+            renderer.prepareMaterial(previewMat);
 
             // Cria o poliedro temporário
             Polyhedron previewPoly = createExtrudedPolyhedron(
@@ -358,40 +365,24 @@ int main() {
                 extrusionState.extrudeDepth, previewMat);
 
             // Renderiza o poliedro de preview
-            for (const auto& face : previewPoly.faces) {
-                Polygon poly2D = camera.projectAndClip(previewPoly, face, w, h);
-
-                if (poly2D.verts.size() >= 3) {
-                    if (currentMode == ShadingMode::Flat) {
-                        glm::vec3 faceCenter(0);
-                        glm::vec3 faceNormal(0);
-                        for (const auto& v : poly2D.verts) {
-                            faceCenter += glm::vec3(v.x, v.y, v.z);
-                            faceNormal += v.normal;
-                        }
-                        faceCenter /= float(poly2D.verts.size());
-                        faceNormal = glm::normalize(faceNormal);
-
-                        float intensity = renderer.phong(faceCenter, faceNormal,
-                                                         *poly2D.material);
-                        renderer.setFlatIntensity(intensity);
-
-                    } else if (currentMode == ShadingMode::Gouraud) {
-                        for (auto& v : poly2D.verts) {
-                            glm::vec3 pos3D(v.x, v.y, v.z);
-                            v.intensity = renderer.phong(pos3D, v.normal,
-                                                         *poly2D.material);
-                        }
-                    }
-
-                    fill_polygon(poly2D, fb, renderer);
-                }
-            }
+            scene.drawPolyhedron(previewPoly, frame, renderer, fb);
         }
 
-        menu(menu_type, shape_type, fb, camera, currentMode, material, fps, extrusionState, transformState, shapes.objects.size());
+        {
+            ProfileScope timer(&profiler, ProfileStage::Hud);
+            // o mapa substitui a cena; o texto fica por cima
+            if (showOverdraw) paint_overdraw(fb);
+            menu(menu_type, shape_type, fb, camera, currentMode, renderer.rasterPath(), renderer.fastMath(), material, fps, extrusionState, transformState, shapes);
+            if (showProfiler) {
+                profiler_overlay(fb, profiler);
+                raster_stats_overlay(fb, scene.stats());
+            }
+        }
 
-        app.drawFramebuffer(fb.colorData(), fb.width(), fb.height());
+        {
+            ProfileScope timer(&profiler, ProfileStage::Upload);
+            app.drawFramebuffer(fb.colorData(), fb.width(), fb.height());
+        }
 
         app.endFrame();
     }
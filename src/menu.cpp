@@ -0,0 +1,900 @@
+#include "../include/menu.h"
+
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+#include "../include/draw.h"
+#include "../include/font8x8.h"
+#include "../include/gl_app.h"  // GLFW_KEY_*
+
+static bool color_check(Color c1, Color c2){
+    if(c1.a==c2.a && c1.r==c2.r && c1.g==c2.g && c1.b==c2.b ) return true;
+    return false;
+}
+
+static bool coefs_check(Material m1, Material m2){
+    if(m1.ka==m2.ka && m1.kd==m2.kd && m1.ks==m2.ks && m1.shininess==m2.shininess ) return true;
+    return false;
+}
+
+static void camera_menu(Framebuffer& fb, Camera camera, ShadingMode currentMode, RasterPath rasterPath, bool fastMath, int fps, int fontScale, int lineH)
+{
+    drawText(fb, 10, 10, "=== MENU PRINCIPAL ===", COLOR_HUD, fontScale);
+    
+    drawText(
+        fb, 10, 10 + lineH,
+        std::string("PROJ: ") +
+            (camera.type == Camera::ProjType::Perspective ? "PERSPECTIVE" : "ORTHO") + " (7)",
+        COLOR_HUD, fontScale);
+
+    drawText(fb, 10, 10 + 2 * lineH,
+             std::string("SHADING: ") +
+                 (currentMode == ShadingMode::Flat      ? "FLAT"
+                  : currentMode == ShadingMode::Gouraud ? "GOURAUD"
+                  : currentMode == ShadingMode::Phong   ? "PHONG"
+                                                        : "DEFERRED") + " (1/2/3/4)",
+             COLOR_HUD, fontScale);
+
+    drawText(
+        fb, 10, 10 + 3 * lineH,
+        std::string("CAMERA: ") +
+            (camera.moveType == Camera::MoveType::Orbit ? "ORBIT" : "FPS") + " (9)",
+        COLOR_HUD, fontScale);
+
+    drawText(
+        fb, 10, 10 + 4 * lineH,
+        std::string("RASTER: ") +
+            (rasterPath == RasterPath::Scanline ? "SCANLINE" : "HALFSPACE") + " (8)",
+        COLOR_HUD, fontScale);
+
+    drawText(fb, 10, 10 + 5 * lineH,
+             std::string("FAST MATH: ") + (fastMath ? "SIM" : "NAO") + " (0)",
+             COLOR_HUD, fontScale);
+
+    drawText(fb, 10, 10 + 6 * lineH,
+             std::string("FPS: ") + std::to_string(fps), COLOR_HUD,
+             fontScale);
+    
+    drawText(fb, 10, 10 + 7 * lineH, "C: COR   F: FORMA   M: MATERIAL", COLOR_HUD, fontScale);
+    drawText(fb, 10, 10 + 8 * lineH, "G: EXTRUDE   H: TRANSFORM", COLOR_HUD, fontScale);
+    drawText(fb, 10, 10 + 9 * lineH, "B: RESET GIZMO   ESC: SAIR", COLOR_HUD, fontScale);
+    drawText(fb, 10, 10 + 10 * lineH, "F3: PERFIL DO FRAME   F4: OVERDRAW", COLOR_HUD, fontScale);
+}
+
+static void color_menu(Framebuffer& fb, Material& material, int fontScale, int lineH){
+    drawText(fb, 10, 10, "=== ESCOLHA COR ===", COLOR_HUD, fontScale);
+    
+    drawText(fb, 10, 10 + 1*lineH, "ESC: VOLTAR", COLOR_HUD, fontScale);
+    
+    drawText(
+        fb, 10, 10 + 2*lineH,
+        std::string("1: PRETO ") +
+        ( color_check(material.color, COLOR_BLACK) ? "<" : ""),
+        COLOR_HUD, fontScale);
+    drawText(
+        fb, 10, 10 + 3*lineH,
+        std::string("2: BRANCO ") +
+        ( color_check(material.color, COLOR_WHITE) ? "<" : ""),
+        COLOR_WHITE, fontScale);
+    drawText(
+        fb, 10, 10 + 4*lineH,
+        std::string("3: VERMELHO ") +
+        ( color_check(material.color, COLOR_RED) ? "<" : ""),
+        COLOR_RED, fontScale);
+    drawText(
+        fb, 10, 10 + 5*lineH,
+        std::string("4: VERDE ") +
+        ( color_check(material.color, COLOR_GREEN) ? "<" : ""),
+        COLOR_GREEN, fontScale);
+    drawText(
+        fb, 10, 10 + 6*lineH,
+        std::string("5: AZUL ") +
+        ( color_check(material.color, COLOR_BLUE) ? "<" : ""),
+        COLOR_BLUE, fontScale);
+    drawText(
+        fb, 10, 10 + 7*lineH,
+        std::string("6: LARANJA ") +
+        ( color_check(material.color, COLOR_ORANGE) ? "<" : ""),
+        COLOR_ORANGE, fontScale);
+    drawText(
+        fb, 10, 10 + 8*lineH,
+        std::string("7: AMARELO ") +
+        ( color_check(material.color, COLOR_YELLOW) ? "<" : ""),
+        COLOR_YELLOW, fontScale);
+    drawText(
+        fb, 10, 10 + 9*lineH,
+        std::string("8: INDIGO ") +
+        ( color_check(material.color, COLOR_INDIGO) ? "<" : ""),
+        COLOR_INDIGO, fontScale);
+    drawText(
+        fb, 10, 10 + 10*lineH,
+        std::string("9: CIANO ") +
+        ( color_check(material.color, COLOR_CYAN) ? "<" : ""),
+        COLOR_CYAN, fontScale);
+    drawText(
+        fb, 10, 10 + 11*lineH,
+        std::string("0: ROSA ") +
+        ( color_check(material.color, COLOR_PINK) ? "<" : ""),
+        COLOR_PINK, fontScale);
+}
+
+static void shape_menu(Framebuffer& fb, ShapeType shape_type, int fontScale, int lineH){
+    drawText(fb, 10, 10, "=== ESCOLHA FORMA ===", COLOR_HUD, fontScale);
+    
+    drawText(fb, 10, 10 + 1*lineH, "ESC: VOLTAR   LMB: CRIAR", COLOR_HUD, fontScale);
+    
+    drawText(
+        fb, 10, 10 + 2*lineH,
+        std::string("1: CUBO ") +
+        ( shape_type == ShapeType::Cube ? "<" : ""),
+        COLOR_HUD, fontScale);
+    drawText(
+        fb, 10, 10 + 3*lineH,
+        std::string("2: ESFERA ") +
+        ( shape_type == ShapeType::Sphere ? "<" : ""),
+        COLOR_HUD, fontScale);
+    drawText(
+        fb, 10, 10 + 4*lineH,
+        std::string("3: CILINDRO ") +
+        ( shape_type == ShapeType::Cylinder ? "<" : ""),
+        COLOR_HUD, fontScale);
+    drawText(
+        fb, 10, 10 + 5*lineH,
+        std::string("4: PIRAMIDE ") +
+        ( shape_type == ShapeType::Pyramid ? "<" : ""),
+        COLOR_HUD, fontScale);
+}
+
+static void materials_menu(Framebuffer& fb, Material material, int fontScale, int lineH){
+    drawText(fb, 10, 10, "=== ESCOLHA MATERIAL ===", COLOR_HUD, fontScale);
+    
+    drawText(fb, 10, 10 + 1*lineH, "ESC: VOLTAR", COLOR_HUD, fontScale);
+    
+    drawText(
+        fb, 10, 10 + 2*lineH,
+        std::string("1: BORRACHA ") +
+        ( coefs_check(material, MATERIAL_RUBBER) ? "<" : ""),
+        COLOR_HUD, fontScale);
+    drawText(
+        fb, 10, 10 + 3*lineH,
+        std::string("2: PLASTICO ") +
+        ( coefs_check(material, MATERIAL_PLASTIC) ? "<" : ""),
+        COLOR_HUD, fontScale);
+    drawText(
+        fb, 10, 10 + 4*lineH,
+        std::string("3: METAL ") +
+        ( coefs_check(material, MATERIAL_METAL) ? "<" : ""),
+        COLOR_HUD, fontScale);
+    drawText(
+        fb, 10, 10 + 5*lineH,
+        std::string("4: PEDRA ") +
+        ( coefs_check(material, MATERIAL_STONE) ? "<" : ""),
+        COLOR_HUD, fontScale);
+    drawText(
+        fb, 10, 10 + 6*lineH,
+        std::string("5: DUAS FACES: ") + (material.doubleSided ? "SIM" : "NAO"),
+        COLOR_HUD, fontScale);
+}
+
+static void extrusion_menu(Framebuffer& fb, const ExtrusionState& extrusionState, int fontScale, int lineH){
+    drawText(fb, 10, 10, "=== MODO EXTRUDE ===", COLOR_HUD, fontScale);
+    
+    if (extrusionState.mode == EditMode::None) {
+        drawText(fb, 10, 10 + lineH, "O: DESENHAR POLIGONO", COLOR_HUD, fontScale);
+        drawText(fb, 10, 10 + 2*lineH, "P: TROCAR PLANO", COLOR_HUD, fontScale);
+        drawText(fb, 10, 10 + 3*lineH, "ESC: VOLTAR", COLOR_HUD, fontScale);
+        
+        std::string planeStr = std::string("PLANO: ") + getPlaneNameString(extrusionState.plane);
+        drawText(fb, 10, 10 + 5*lineH, planeStr, COLOR_HUD, fontScale);
+        
+    } else if (extrusionState.mode == EditMode::Draw) {
+        drawText(fb, 10, 10 + lineH, "LMB: ADICIONAR VERTICE", COLOR_HUD, fontScale);
+        drawText(fb, 10, 10 + 2*lineH, "SPACE: INICIAR EXTRUDE", COLOR_HUD, fontScale);
+        drawText(fb, 10, 10 + 3*lineH, "ESC: CANCELAR", COLOR_HUD, fontScale);
+
+        std::string info = std::string("PLANO: ") +
+                           getPlaneNameString(extrusionState.plane) +
+                           "  VERT: " +
+                           std::to_string(extrusionState.polygon3D.size());
+
+        drawText(fb, 10, 10 + 5*lineH, info, COLOR_HUD, fontScale);
+        
+    } else if (extrusionState.mode == EditMode::Extrude) {
+        drawText(fb, 10, 10 + lineH, "MOUSE: AJUSTAR ALTURA", COLOR_HUD, fontScale);
+        drawText(fb, 10, 10 + 2*lineH, "SPACE: CONFIRMAR", COLOR_HUD, fontScale);
+        drawText(fb, 10, 10 + 3*lineH, "ESC: CANCELAR", COLOR_HUD, fontScale);
+
+        char depthStr[64];
+        std::snprintf(depthStr, sizeof(depthStr), "ALTURA: %.2f",
+                      extrusionState.extrudeDepth);
+        drawText(fb, 10, 10 + 5*lineH, depthStr, COLOR_HUD, fontScale);
+    }
+}
+
+static void transform_menu(Framebuffer& fb, const TransformState& transformState, const Shapes& shapes, int fontScale, int lineH){
+    drawText(fb, 10, 10, "=== MODO TRANSFORM ===", COLOR_HUD, fontScale);
+    
+    std::string shapeInfo = std::string("SHAPE: ") + 
+                           (shapes.objects.contains(transformState.selectedShape) ? 
+                            std::to_string(shapes.objects.indexOf(transformState.selectedShape) + 1) + "/" + std::to_string(shapes.objects.size()) :
+                            "NENHUM");
+    drawText(fb, 10, 10 + lineH, shapeInfo, COLOR_HUD, fontScale);
+    
+    drawText(fb, 10, 10 + 2*lineH, "TAB: PROXIMO   CLIQUE: SELECIONAR", COLOR_HUD, fontScale);
+    drawText(fb, 10, 10 + 3*lineH, "T: TRANSLACAO   R: ROTACAO", COLOR_HUD, fontScale);
+    drawText(fb, 10, 10 + 4*lineH, "Z/X: ESCALA -/+   DEL: APAGAR", COLOR_HUD, fontScale);
+    drawText(fb, 10, 10 + 5*lineH, "C: COR   M: MATERIAL", COLOR_HUD, fontScale);
+    drawText(fb, 10, 10 + 6*lineH, "ESC: VOLTAR", COLOR_HUD, fontScale);
+    
+    if (transformState.mode == TransformMode::Translate) {
+        drawText(fb, 10, 10 + 8*lineH, "MODO: TRANSLACAO", COLOR_HUD, fontScale);
+        drawText(fb, 10, 10 + 9*lineH, "SPACE: CONFIRMAR", COLOR_HUD, fontScale);
+    } else if (transformState.mode == TransformMode::Rotate) {
+        drawText(fb, 10, 10 + 8*lineH, "MODO: ROTACAO", COLOR_HUD, fontScale);
+        drawText(fb, 10, 10 + 9*lineH, "MOUSE: GIRAR   SPACE: CONFIRMAR", COLOR_HUD, fontScale);
+    } else if (transformState.mode == TransformMode::Scale) {
+        drawText(fb, 10, 10 + 8*lineH, "MODO: ESCALA", COLOR_HUD, fontScale);
+    }
+}
+
+void menu(MenuType menu_type, ShapeType shape_type, Framebuffer& fb, Camera camera, ShadingMode currentMode, RasterPath rasterPath, bool fastMath, Material material, int fps, const ExtrusionState& extrusionState, const TransformState& transformState, const Shapes& shapes){
+
+    int fontScale = 2;
+    int lineH = 8 * fontScale + 4; // altura da linha com margin
+
+    switch (menu_type)
+    {
+        case MenuType::Camera:
+        camera_menu(fb, camera, currentMode, rasterPath, fastMath, fps, fontScale, lineH);
+        break;
+        case MenuType::Color:
+        color_menu(fb, material, fontScale, lineH);
+        break;
+        case MenuType::Shape:
+        shape_menu(fb, shape_type, fontScale, lineH);
+        break;
+        case MenuType::Materials:
+        materials_menu(fb, material, fontScale, lineH);
+        break;
+        case MenuType::Extrusion:
+        extrusion_menu(fb, extrusionState, fontScale, lineH);
+        break;
+        case MenuType::Transform:
+        transform_menu(fb, transformState, shapes, fontScale, lineH);
+        break;
+    }
+}
+
+static void extrusion_key(int key, MenuType &menu_type, ShapeType &shape_type, Camera &camera, Material &material, ShadingMode &currentMode, Renderer &renderer, float moveStep, ExtrusionState &extrusionState, Shapes &shapes)
+{
+    switch (key)
+    {
+    case GLFW_KEY_ESCAPE:
+        if (extrusionState.mode != EditMode::None) {
+            extrusionState.mode = EditMode::None;
+            extrusionState.polygon3D.clear();
+            extrusionState.hasPreview = false;
+        } else {
+            menu_type = MenuType::Camera;
+        }
+        break;
+    case GLFW_KEY_O:
+        extrusionState.mode = EditMode::Draw;
+        extrusionState.polygon3D.clear();
+        extrusionState.hasPreview = false;
+        break;
+    case GLFW_KEY_P:
+        if (extrusionState.plane == DrawPlane::XY)
+            extrusionState.plane = DrawPlane::XZ;
+        else if (extrusionState.plane == DrawPlane::XZ)
+            extrusionState.plane = DrawPlane::YZ;
+        else
+            extrusionState.plane = DrawPlane::XY;
+        std::cout << "Plano: " << getPlaneNameString(extrusionState.plane) << "\n";
+        break;
+    case GLFW_KEY_SPACE:
+        if (extrusionState.mode == EditMode::Draw &&
+            extrusionState.polygon3D.size() >= 3) {
+            extrusionState.mode = EditMode::Extrude;
+            extrusionState.extrudeDepth = 0.0f;
+            extrusionState.extrudeStartPoint = extrusionState.polygon3D[0];
+        } else if (extrusionState.mode == EditMode::Extrude) {
+            buildExtrudedSolid(extrusionState.polygon3D, extrusionState.plane,
+                             extrusionState.extrudeDepth, shapes, material);
+            extrusionState.mode = EditMode::None;
+            extrusionState.polygon3D.clear();
+            extrusionState.hasPreview = false;
+        }
+        break;
+    }
+}
+
+static void transform_key(int key, MenuType &menu_type, ShapeType &shape_type, Camera &camera, Material &material, ShadingMode &currentMode, Renderer &renderer, float moveStep, TransformState &transformState, Shapes &shapes)
+{
+    switch (key)
+    {
+    case GLFW_KEY_ESCAPE:
+        if (transformState.mode != TransformMode::None) {
+            // Cancela a transformação atual
+            transformState.mode = TransformMode::None;
+        } else {
+            menu_type = MenuType::Camera;
+        }
+        break;
+    case GLFW_KEY_C:
+        transformState.previousMenu = MenuType::Transform;
+        menu_type = MenuType::Color;
+        break;
+    case GLFW_KEY_M:
+        transformState.previousMenu = MenuType::Transform;
+        menu_type = MenuType::Materials;
+        break;
+    case GLFW_KEY_TAB:
+        // Seleciona o próximo shape
+        if (!shapes.objects.empty()) {
+            // ordem densa do pool (muda quando algum shape é apagado)
+            if (!shapes.objects.contains(transformState.selectedShape)) {
+                transformState.selectedShape = shapes.objects.handleAt(0);
+            } else {
+                size_t next = (shapes.objects.indexOf(transformState.selectedShape) + 1) % shapes.objects.size();
+                transformState.selectedShape = shapes.objects.handleAt(next);
+            }
+            
+            // Mover o look da câmera para o centro do objeto selecionado
+            camera.look = shapes.objects[transformState.selectedShape].center();
+            
+            // Forçar atualização da posição da câmera em modo Orbit
+            // Isso recalcula eye baseado no novo look
+            camera.addOrbitDistance(0);
+            
+            std::cout << "Shape selecionado: " << (shapes.objects.indexOf(transformState.selectedShape) + 1) << "/" << shapes.objects.size() << " - Camera look movido para (" << camera.look.x << ", " << camera.look.y << ", " << camera.look.z << ")\n";
+        } else {
+            std::cout << "Nenhum shape disponível para selecionar\n";
+        }
+        break;
+    case GLFW_KEY_T:
+        if (shapes.objects.contains(transformState.selectedShape)) {
+            transformState.mode = TransformMode::Translate;
+            // Salvar posição original para possível cancelamento
+            std::cout << "Modo: Translação\n";
+        }
+        break;
+    case GLFW_KEY_R:
+        if (shapes.objects.contains(transformState.selectedShape)) {
+            transformState.mode = TransformMode::Rotate;
+            transformState.lastAngleX = 0.0f;
+            transformState.lastAngleY = 0.0f;
+            std::cout << "Modo: Rotação\n";
+        }
+        break;
+    case GLFW_KEY_Z:
+        // Diminuir escala
+        if (shapes.objects.contains(transformState.selectedShape)) {
+            shapes.objects[transformState.selectedShape].scale(0.9f);
+            shapes.refit(transformState.selectedShape);
+            std::cout << "Escala diminuída\n";
+        }
+        break;
+    case GLFW_KEY_X:
+        // Aumentar escala
+        if (shapes.objects.contains(transformState.selectedShape)) {
+            shapes.objects[transformState.selectedShape].scale(1.1f);
+            shapes.refit(transformState.selectedShape);
+            std::cout << "Escala aumentada\n";
+        }
+        break;
+    case GLFW_KEY_SPACE:
+        if (transformState.mode == TransformMode::Translate || transformState.mode == TransformMode::Rotate) {
+            transformState.mode = TransformMode::None;
+            std::cout << "Transformação confirmada\n";
+        }
+        break;
+    case GLFW_KEY_DELETE:
+    case GLFW_KEY_BACKSPACE:
+        // Deletar o objeto selecionado
+        if (shapes.objects.contains(transformState.selectedShape)) {
+            size_t index = shapes.objects.indexOf(transformState.selectedShape);
+            std::cout << "Deletando shape " << (index + 1) << "\n";
+            shapes.remove(transformState.selectedShape);
+            
+            // Selecionar o shape que ficou na mesma posição
+            if (shapes.objects.empty()) {
+                transformState.selectedShape = SlotHandle{};
+                std::cout << "Nenhum shape restante\n";
+            } else {
+                // Se deletou o último, volta para o anterior
+                if (index >= shapes.objects.size()) {
+                    index = shapes.objects.size() - 1;
+                }
+                transformState.selectedShape = shapes.objects.handleAt(index);
+                std::cout << "Shape " << (index + 1) << " agora selecionado\n";
+                
+                // Mover câmera para o novo shape selecionado
+                camera.look = shapes.objects[transformState.selectedShape].center();
+                camera.addOrbitDistance(0);
+            }
+        }
+        break;
+    case GLFW_KEY_W:
+        camera.moveZ(moveStep);
+        break;
+    case GLFW_KEY_S:
+        camera.moveZ(-moveStep);
+        break;
+    case GLFW_KEY_A:
+        camera.moveX(-moveStep);
+        break;
+    case GLFW_KEY_D:
+        camera.moveX(moveStep);
+        break;
+    case GLFW_KEY_Q:
+        camera.moveY(moveStep);
+        break;
+    case GLFW_KEY_E:
+        camera.moveY(-moveStep);
+        break;
+    }
+}
+
+static void camera_key(int key, MenuType &menu_type, ShapeType &shape_type, Camera &camera, Material &material, ShadingMode &currentMode, Renderer &renderer, float moveStep, TransformState &transformState, Shapes &shapes)
+{
+    switch (key)
+    {
+    case GLFW_KEY_ESCAPE:
+        glfwSetWindowShouldClose(glfwGetCurrentContext(), 1);
+        break;
+    case GLFW_KEY_C:
+        menu_type = MenuType::Color;
+        break;
+    case GLFW_KEY_F:
+        menu_type = MenuType::Shape;
+        break;
+    case GLFW_KEY_M:
+        menu_type = MenuType::Materials;
+        break;
+    case GLFW_KEY_G:
+        menu_type = MenuType::Extrusion;
+        break;
+    case GLFW_KEY_H:
+        menu_type = MenuType::Transform;
+        // Inicializar com o primeiro shape se houver algum
+        if (!shapes.objects.empty()) {
+            if (!shapes.objects.contains(transformState.selectedShape)) {
+                transformState.selectedShape = shapes.objects.handleAt(0);
+                std::cout << "Transform mode iniciado - Shape 0 selecionado\n";
+            }
+            std::cout << "Entrando no modo Transform - Shapes disponíveis: " << shapes.objects.size() << ", Selecionado: " << shapes.objects.indexOf(transformState.selectedShape) << "\n";
+        } else {
+            std::cout << "Transform mode - NENHUM shape disponível!\n";
+        }
+        break;
+    case GLFW_KEY_W:
+        camera.moveZ(moveStep);
+        break;
+    case GLFW_KEY_S:
+        camera.moveZ(-moveStep);
+        break;
+    case GLFW_KEY_A:
+        camera.moveX(-moveStep);
+        break;
+    case GLFW_KEY_D:
+        camera.moveX(moveStep);
+        break;
+    case GLFW_KEY_Q:
+        camera.moveY(moveStep);
+        break;
+    case GLFW_KEY_E:
+        camera.moveY(-moveStep);
+        break;
+    case GLFW_KEY_B:
+        camera.look = glm::vec3(0, 0, 0);
+        // Forçar atualização da câmera
+        camera.addOrbitDistance(0);
+        std::cout << "Gizmo resetado para o centro (0,0,0)\n";
+        break;
+    case GLFW_KEY_1:
+        currentMode = ShadingMode::Flat;
+        renderer.setMode(currentMode);
+        std::cout << "Modo: Flat Shading\n";
+        break;
+    case GLFW_KEY_2:
+        currentMode = ShadingMode::Gouraud;
+        renderer.setMode(currentMode);
+        std::cout << "Modo: Gouraud Shading\n";
+        break;
+    case GLFW_KEY_3:
+        currentMode = ShadingMode::Phong;
+        renderer.setMode(currentMode);
+        std::cout << "Modo: Phong Shading\n";
+        break;
+    case GLFW_KEY_4:
+        currentMode = ShadingMode::Deferred;
+        renderer.setMode(currentMode);
+        std::cout << "Modo: Deferred (visibility buffer)\n";
+        break;
+    case GLFW_KEY_8:
+        // Toggle entre scanline (ET/AET) e half-space
+        if (renderer.rasterPath() == RasterPath::Scanline) {
+            renderer.setRasterPath(RasterPath::HalfSpace);
+            std::cout << "Raster: Half-space\n";
+        } else {
+            renderer.setRasterPath(RasterPath::Scanline);
+            std::cout << "Raster: Scanline\n";
+        }
+        break;
+    case GLFW_KEY_0:
+        // tabelas + rsqrt aproximado no shading por pixel
+        renderer.setFastMath(!renderer.fastMath());
+        std::cout << "Fast math: " << (renderer.fastMath() ? "on" : "off") << "\n";
+        break;
+    case GLFW_KEY_7:
+        // Toggle entre Perspective e Ortho
+        if (camera.type == Camera::ProjType::Perspective) {
+            camera.type = Camera::ProjType::Ortho;
+            std::cout << "Camera Projection: Orthogonal\n";
+        } else {
+            camera.type = Camera::ProjType::Perspective;
+            std::cout << "Camera Projection: Perspective\n";
+        }
+        break;
+    case GLFW_KEY_9:
+        // Toggle entre FPS e Orbit
+        if (camera.moveType == Camera::MoveType::Fps) {
+            camera.moveType = Camera::MoveType::Orbit;
+            std::cout << "Camera Mode: Orbit\n";
+        } else {
+            camera.moveType = Camera::MoveType::Fps;
+            std::cout << "Camera Mode: FPS\n";
+        }
+        break;
+    }
+}
+
+static void color_key(int key, MenuType &menu_type, ShapeType &shape_type, Camera &camera, Material &material, ShadingMode &currentMode, Renderer &renderer, float moveStep, TransformState &transformState, Shapes &shapes, MenuType previousMenu)
+{
+    static bool debugPrinted = false;
+    if (!debugPrinted && previousMenu == MenuType::Transform) {
+        std::cout << "Color menu - previousMenu: Transform, selectedShape: " << (shapes.objects.contains(transformState.selectedShape) ? (int)shapes.objects.indexOf(transformState.selectedShape) : -1) << "\n";
+        debugPrinted = true;
+    }
+    
+    switch (key)
+    {
+    case GLFW_KEY_ESCAPE:
+        menu_type = previousMenu;
+        debugPrinted = false;
+        break;
+    case GLFW_KEY_C:
+        menu_type = MenuType::Color;
+        break;
+    case GLFW_KEY_F:
+        menu_type = MenuType::Shape;
+        break;
+    case GLFW_KEY_M:
+        menu_type = MenuType::Materials;
+        break;
+    case GLFW_KEY_W:
+        camera.moveZ(moveStep);
+        break;
+    case GLFW_KEY_S:
+        camera.moveZ(-moveStep);
+        break;
+    case GLFW_KEY_A:
+        camera.moveX(-moveStep);
+        break;
+    case GLFW_KEY_D:
+        camera.moveX(moveStep);
+        break;
+    case GLFW_KEY_Q:
+        camera.moveY(moveStep);
+        break;
+    case GLFW_KEY_E:
+        camera.moveY(-moveStep);
+        break;
+    case GLFW_KEY_1:
+        material.color = COLOR_BLACK;
+        if (previousMenu == MenuType::Transform && shapes.objects.contains(transformState.selectedShape)) {
+            shapes.objects[transformState.selectedShape].material.color = COLOR_BLACK;
+            std::cout << "Cor PRETO aplicada ao shape " << shapes.objects.indexOf(transformState.selectedShape) << "\n";
+        }
+        break;
+    case GLFW_KEY_2:
+        material.color = COLOR_WHITE;
+        if (previousMenu == MenuType::Transform && shapes.objects.contains(transformState.selectedShape)) {
+            shapes.objects[transformState.selectedShape].material.color = COLOR_WHITE;
+        }
+        break;
+    case GLFW_KEY_3:
+        material.color = COLOR_RED;
+        if (previousMenu == MenuType::Transform && shapes.objects.contains(transformState.selectedShape)) {
+            shapes.objects[transformState.selectedShape].material.color = COLOR_RED;
+        }
+        break;
+    case GLFW_KEY_4:
+        material.color = COLOR_GREEN;
+        if (previousMenu == MenuType::Transform && shapes.objects.contains(transformState.selectedShape)) {
+            shapes.objects[transformState.selectedShape].material.color = COLOR_GREEN;
+        }
+        break;
+    case GLFW_KEY_5:
+        material.color = COLOR_BLUE;
+        if (previousMenu == MenuType::Transform && shapes.objects.contains(transformState.selectedShape)) {
+            shapes.objects[transformState.selectedShape].material.color = COLOR_BLUE;
+        }
+        break;
+    case GLFW_KEY_6:
+        material.color = COLOR_ORANGE;
+        if (previousMenu == MenuType::Transform && shapes.objects.contains(transformState.selectedShape)) {
+            shapes.objects[transformState.selectedShape].material.color = COLOR_ORANGE;
+        }
+        break;
+    case GLFW_KEY_7:
+        material.color = COLOR_YELLOW;
+        if (previousMenu == MenuType::Transform && shapes.objects.contains(transformState.selectedShape)) {
+            shapes.objects[transformState.selectedShape].material.color = COLOR_YELLOW;
+        }
+        break;
+    case GLFW_KEY_8:
+        material.color = COLOR_INDIGO;
+        if (previousMenu == MenuType::Transform && shapes.objects.contains(transformState.selectedShape)) {
+            shapes.objects[transformState.selectedShape].material.color = COLOR_INDIGO;
+        }
+        break;
+    case GLFW_KEY_9:
+        material.color = COLOR_CYAN;
+        if (previousMenu == MenuType::Transform && shapes.objects.contains(transformState.selectedShape)) {
+            shapes.objects[transformState.selectedShape].material.color = COLOR_CYAN;
+        }
+        break;
+    case GLFW_KEY_0:
+        material.color = COLOR_PINK;
+        if (previousMenu == MenuType::Transform && shapes.objects.contains(transformState.selectedShape)) {
+            shapes.objects[transformState.selectedShape].material.color = COLOR_PINK;
+        }
+        break;
+    }
+}
+
+static void shape_key(int key, MenuType &menu_type, ShapeType &shape_type, Camera &camera, Material &material, ShadingMode &currentMode, Renderer &renderer, float moveStep)
+{
+    switch (key)
+    {
+    case GLFW_KEY_ESCAPE:
+        menu_type = MenuType::Camera;
+        break;
+    case GLFW_KEY_C:
+        menu_type = MenuType::Color;
+        break;
+    case GLFW_KEY_F:
+        menu_type = MenuType::Shape;
+        break;
+    case GLFW_KEY_M:
+        menu_type = MenuType::Materials;
+        break;
+    case GLFW_KEY_W:
+        camera.moveZ(moveStep);
+        break;
+    case GLFW_KEY_S:
+        camera.moveZ(-moveStep);
+        break;
+    case GLFW_KEY_A:
+        camera.moveX(-moveStep);
+        break;
+    case GLFW_KEY_D:
+        camera.moveX(moveStep);
+        break;
+    case GLFW_KEY_Q:
+        camera.moveY(moveStep);
+        break;
+    case GLFW_KEY_E:
+        camera.moveY(-moveStep);
+        break;
+    case GLFW_KEY_1:
+        shape_type = ShapeType::Cube;
+        break;
+    case GLFW_KEY_2:
+        shape_type = ShapeType::Sphere;
+        break;
+    case GLFW_KEY_3:
+        shape_type = ShapeType::Cylinder;
+        break;
+    case GLFW_KEY_4:
+        shape_type = ShapeType::Pyramid;
+        break;
+    }
+}
+
+static void materials_key(int key, MenuType &menu_type, ShapeType &shape_type, Camera &camera, Material &material, ShadingMode &currentMode, Renderer &renderer, float moveStep, TransformState &transformState, Shapes &shapes, MenuType previousMenu)
+{
+    Material Rubber = MATERIAL_RUBBER, Plastic = MATERIAL_PLASTIC, Metal = MATERIAL_METAL, Stone = MATERIAL_STONE;
+    switch (key)
+    {
+    case GLFW_KEY_ESCAPE:
+        menu_type = previousMenu;
+        break;
+    case GLFW_KEY_C:
+        menu_type = MenuType::Color;
+        break;
+    case GLFW_KEY_F:
+        menu_type = MenuType::Shape;
+        break;
+    case GLFW_KEY_M:
+        menu_type = MenuType::Materials;
+        break;
+    case GLFW_KEY_W:
+        camera.moveZ(moveStep);
+        break;
+    case GLFW_KEY_S:
+        camera.moveZ(-moveStep);
+        break;
+    case GLFW_KEY_A:
+        camera.moveX(-moveStep);
+        break;
+    case GLFW_KEY_D:
+        camera.moveX(moveStep);
+        break;
+    case GLFW_KEY_Q:
+        camera.moveY(moveStep);
+        break;
+    case GLFW_KEY_E:
+        camera.moveY(-moveStep);
+        break;
+    case GLFW_KEY_1:
+        material.ka = Rubber.ka;
+        material.kd = Rubber.kd;
+        material.ks = Rubber.ks;
+        material.shininess = Rubber.shininess;
+        if (previousMenu == MenuType::Transform && shapes.objects.contains(transformState.selectedShape)) {
+            shapes.objects[transformState.selectedShape].material.ka = Rubber.ka;
+            shapes.objects[transformState.selectedShape].material.kd = Rubber.kd;
+            shapes.objects[transformState.selectedShape].material.ks = Rubber.ks;
+            shapes.objects[transformState.selectedShape].material.shininess = Rubber.shininess;
+            shapes.objects[transformState.selectedShape].invalidateLighting();
+        }
+        break;
+    case GLFW_KEY_2:
+        material.ka = Plastic.ka;
+        material.kd = Plastic.kd;
+        material.ks = Plastic.ks;
+        material.shininess = Plastic.shininess;
+        if (previousMenu == MenuType::Transform && shapes.objects.contains(transformState.selectedShape)) {
+            shapes.objects[transformState.selectedShape].material.ka = Plastic.ka;
+            shapes.objects[transformState.selectedShape].material.kd = Plastic.kd;
+            shapes.objects[transformState.selectedShape].material.ks = Plastic.ks;
+            shapes.objects[transformState.selectedShape].material.shininess = Plastic.shininess;
+            shapes.objects[transformState.selectedShape].invalidateLighting();
+        }
+        break;
+    case GLFW_KEY_3:
+        material.ka = Metal.ka;
+        material.kd = Metal.kd;
+        material.ks = Metal.ks;
+        material.shininess = Metal.shininess;
+        if (previousMenu == MenuType::Transform && shapes.objects.contains(transformState.selectedShape)) {
+            shapes.objects[transformState.selectedShape].material.ka = Metal.ka;
+            shapes.objects[transformState.selectedShape].material.kd = Metal.kd;
+            shapes.objects[transformState.selectedShape].material.ks = Metal.ks;
+            shapes.objects[transformState.selectedShape].material.shininess = Metal.shininess;
+            shapes.objects[transformState.selectedShape].invalidateLighting();
+        }
+        break;
+    case GLFW_KEY_4:
+        material.ka = Stone.ka;
+        material.kd = Stone.kd;
+        material.ks = Stone.ks;
+        material.shininess = Stone.shininess;
+        if (previousMenu == MenuType::Transform && shapes.objects.contains(transformState.selectedShape)) {
+            shapes.objects[transformState.selectedShape].material.ka = Stone.ka;
+            shapes.objects[transformState.selectedShape].material.kd = Stone.kd;
+            shapes.objects[transformState.selectedShape].material.ks = Stone.ks;
+            shapes.objects[transformState.selectedShape].material.shininess = Stone.shininess;
+            shapes.objects[transformState.selectedShape].invalidateLighting();
+        }
+        break;
+    case GLFW_KEY_5:
+        // desliga o backface culling (superfícies abertas)
+        material.doubleSided = !material.doubleSided;
+        if (previousMenu == MenuType::Transform && shapes.objects.contains(transformState.selectedShape)) {
+            shapes.objects[transformState.selectedShape].material.doubleSided = material.doubleSided;
+        }
+        break;
+    }
+}
+
+void key_press(int key, MenuType& menu_type, ShapeType& shape_type, Camera& camera, Material& material, ShadingMode& currentMode, Renderer& renderer, ExtrusionState& extrusionState, Shapes& shapes, TransformState& transformState){
+    const float moveStep = 0.2f;
+    
+    // Guardar menu anterior antes de mudar
+    MenuType previousMenu = transformState.previousMenu;
+
+    switch (menu_type)
+    {
+    case MenuType::Camera:
+        camera_key(key,menu_type,shape_type,camera,material,currentMode,renderer,moveStep,transformState,shapes);
+        break;
+    case MenuType::Color:
+        color_key(key,menu_type,shape_type,camera,material,currentMode,renderer,moveStep,transformState,shapes,previousMenu);
+        break;
+    case MenuType::Shape:
+        shape_key(key,menu_type,shape_type,camera,material,currentMode,renderer,moveStep);
+        break;
+    case MenuType::Materials:
+        materials_key(key,menu_type,shape_type,camera,material,currentMode,renderer,moveStep,transformState,shapes,previousMenu);
+        break;
+    case MenuType::Extrusion:
+        extrusion_key(key,menu_type,shape_type,camera,material,currentMode,renderer,moveStep,extrusionState,shapes);
+        break;
+    case MenuType::Transform:
+        transform_key(key,menu_type,shape_type,camera,material,currentMode,renderer,moveStep,transformState,shapes);
+        break;
+    }
+
+}
+
+void profiler_overlay(Framebuffer& fb, const FrameProfiler& profiler){
+    int fontScale = 2;
+    int lineH = 8 * fontScale + 4;
+    const int cols = 22;  // largura da coluna em caracteres
+    int x = fb.width() - 10 - cols * 8 * fontScale;
+    int y = 10;
+
+    FrameProfiler::Summary s = profiler.summary();
+    char line[64];
+
+    drawText(fb, x, y, "=== PERFIL (MS) ===", COLOR_HUD, fontScale);
+    y += lineH;
+    for (int k = 0; k < FrameProfiler::STAGES; k++) {
+        std::snprintf(line, sizeof line, "%-10s%7.2f",
+                      FrameProfiler::stageName(ProfileStage(k)), s.stageMs[k]);
+        drawText(fb, x, y, line, COLOR_HUD, fontScale);
+        y += lineH;
+    }
+    std::snprintf(line, sizeof line, "%-10s%7.2f", "OUTROS", s.otherMs);
+    drawText(fb, x, y, line, COLOR_HUD, fontScale);
+    y += lineH;
+
+    std::snprintf(line, sizeof line, "P50 %.1f P99 %.1f", s.p50, s.p99);
+    drawText(fb, x, y, line, COLOR_HUD, fontScale);
+    y += lineH;
+    std::snprintf(line, sizeof line, "MAX %.1f  %d FRAMES", s.max, s.frames);
+    drawText(fb, x, y, line, COLOR_HUD, fontScale);
+}
+
+void raster_stats_overlay(Framebuffer& fb, const RasterStats& stats){
+    int fontScale = 2;
+    int lineH = 8 * fontScale + 4;
+    const int cols = 22;
+
+    struct Row { const char* name; uint64_t value; };
+    const Row rows[] = {
+        {"POLIGONOS", stats.polygonsSubmitted},
+        {"BACKFACE", stats.polygonsCulled},
+        {"RECORTADOS", stats.polygonsClipped},
+        {"HI-Z", stats.hizRejects},
+        {"HI-Z PIXELS", stats.hizPixels},
+        {"SHADED", stats.pixelsShaded},
+        {"Z PASSOU", stats.depthPasses},
+        {"Z FALHOU", stats.depthRejects},
+        {"LINHAS", stats.linePixels},
+    };
+    const int n = int(sizeof(rows) / sizeof(rows[0]));
+
+    int x = fb.width() - 10 - cols * 8 * fontScale;
+    int y = fb.height() - 10 - (n + 2) * lineH;
+    char line[64];
+
+    drawText(fb, x, y, "=== RASTER ===", COLOR_HUD, fontScale);
+    y += lineH;
+    for (const Row& r : rows) {
+        std::snprintf(line, sizeof line, "%-12s%9llu", r.name,
+                      (unsigned long long)r.value);
+        drawText(fb, x, y, line, COLOR_HUD, fontScale);
+        y += lineH;
+    }
+
+    // z-tests aprovados por pixel da tela (1.0 = sem overdraw na média)
+    double perPixel = double(stats.depthPasses) / (double(fb.width()) * fb.height());
+    std::snprintf(line, sizeof line, "OVERDRAW %.2f  F4", perPixel);
+    drawText(fb, x, y, line, COLOR_HUD, fontScale);
+}
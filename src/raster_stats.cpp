@@ -0,0 +1,24 @@
+#include "../include/raster_stats.h"
+
+#include <algorithm>
+
+void paint_overdraw(Framebuffer& fb) {
+    if (!fb.overdrawTracking()) return;
+
+    static const Color heat[] = {
+        {15, 15, 20, 255},   // 0: nada desenhado
+        {40, 60, 220, 255},  // 1: sem overdraw
+        {0, 200, 220, 255},
+        {40, 200, 60, 255},
+        {230, 220, 40, 255},
+        {240, 140, 20, 255},
+        {230, 30, 30, 255},  // 6 ou mais
+    };
+    const int LAST = int(sizeof(heat) / sizeof(heat[0])) - 1;
+
+    for (int y = 0; y < fb.height(); y++) {
+        const uint16_t* count = fb.overdrawRow(y);
+        for (int x = 0; x < fb.width(); x++)
+            fb.setRaw(x, y, heat[std::min(int(count[x]), LAST)]);
+    }
+}
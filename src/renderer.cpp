@@ -1,5 +1,7 @@
 #include "../include/renderer.h"
 #include <algorithm>
+#include <cmath>
+#include <cstring>
 
 using glm::vec3;
 using std::max;
@@ -33,6 +35,76 @@ float Renderer::phong(const vec3& pos,
     return std::clamp(I, 0.0f, 1.0f);
 }
 
+// 1/sqrt(x): chute pelos bits do float e dois passos de Newton (erro
+// relativo ~5e-6)
+static inline float fast_rsqrt(float x) {
+    uint32_t i;
+    std::memcpy(&i, &x, sizeof i);
+    i = 0x5f375a86 - (i >> 1);
+    float y;
+    std::memcpy(&y, &i, sizeof y);
+    y = y * (1.5f - 0.5f * x * y * y);
+    y = y * (1.5f - 0.5f * x * y * y);
+    return y;
+}
+
+static inline vec3 fast_normalize(const vec3& v) {
+    return v * fast_rsqrt(glm::dot(v, v));
+}
+
+float Renderer::phongFast(const vec3& pos,
+                          const vec3& normal,
+                          const Material& mat,
+                          const ShadingTable& table) const
+{
+    vec3 N = fast_normalize(normal);
+    vec3 L = fast_normalize(light.pos - pos);
+    vec3 V = fast_normalize(eye - pos);
+    vec3 H = fast_normalize(L + V);
+
+    float diff = max(glm::dot(N, L), 0.0f);
+    float spec = 0.0f;
+    if (diff > 0.0f)
+        spec = table.specular(max(glm::dot(N, H), 0.0f));
+
+    float I =
+        mat.ka +
+        mat.kd * diff * light.intensity +
+        mat.ks * spec * light.intensity;
+
+    return std::clamp(I, 0.0f, 1.0f);
+}
+
+void Renderer::prepareMaterial(Material& mat) {
+    if (!fast) {
+        mat.table = nullptr;
+        return;
+    }
+
+    uint32_t rgba = (uint32_t(mat.color.a) << 24) | (uint32_t(mat.color.b) << 16) |
+                    (uint32_t(mat.color.g) << 8) | uint32_t(mat.color.r);
+    auto& slot = (*tables)[{rgba, mat.shininess}];
+    if (slot) {
+        mat.table = slot;
+        return;
+    }
+
+    slot = std::make_shared<ShadingTable>();
+    slot->color = mat.color;
+    slot->shininess = mat.shininess;
+    for (int i = 0; i <= ShadingTable::SPEC_SIZE; i++)
+        slot->spec[i] = std::pow(float(i) / ShadingTable::SPEC_SIZE, mat.shininess);
+    for (int i = 0; i < 256; i++)
+        slot->shaded[i] = modulate(mat.color, float(i) / 255.0f);
+    mat.table = slot;  // solta a tabela antiga antes da varredura
+
+    // tabela nova: descarta as que só o mapa ainda segura
+    for (auto it = tables->begin(); it != tables->end();) {
+        if (it->second.use_count() == 1) it = tables->erase(it);
+        else ++it;
+    }
+}
+
 Color Renderer::shadePixel(const Material& mat,
                            float intensity,
                            const vec3& normal,
@@ -40,15 +112,14 @@ Color Renderer::shadePixel(const Material& mat,
 {
     switch (mode) {
     case ShadingMode::Flat:
-        return modulate(mat.color, flatI);
+        return shade<ShadingMode::Flat>(mat, intensity, normal, pos);
 
     case ShadingMode::Gouraud:
-        return modulate(mat.color, intensity);
+        return shade<ShadingMode::Gouraud>(mat, intensity, normal, pos);
 
-    case ShadingMode::Phong: {
-        float I = phong(pos, normal, mat);
-        return modulate(mat.color, I);
-    }
+    case ShadingMode::Phong:
+    case ShadingMode::Deferred:
+        return shade<ShadingMode::Phong>(mat, intensity, normal, pos);
     }
 
     return mat.color; // fallback
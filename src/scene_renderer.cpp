@@ -0,0 +1,143 @@
+#include "../include/scene_renderer.h"
+
+#include <algorithm>
+
+void SceneRenderer::begin(const Framebuffer& fb) {
+    binner.begin(fb.width(), fb.height());
+    visibility.begin(fb.width(), fb.height());
+}
+
+void SceneRenderer::flush(Framebuffer& fb, const Renderer& renderer) {
+    binner.flush(fb, renderer);
+    visibility.resolve(fb, renderer);
+    binner.takeStats(frameStats);
+    visibility.takeStats(frameStats);
+}
+
+void SceneRenderer::submit(Polygon& poly, Renderer& renderer, Framebuffer& fb) {
+    if (poly.verts.size() < 3) {
+        frameStats.polygonsClipped++;
+        return;
+    }
+    frameStats.polygonsSubmitted++;
+
+    ShadingMode mode = renderer.shadingMode();
+    float flatI = 1.0f;
+    if (mode == ShadingMode::Flat) {
+        glm::vec3 faceCenter(0);
+        glm::vec3 faceNormal(0);
+        for (const auto& v : poly.verts) {
+            faceCenter += glm::vec3(v.x, v.y, v.z);
+            faceNormal += v.normal;
+        }
+        faceCenter /= float(poly.verts.size());
+        faceNormal = glm::normalize(faceNormal);
+
+        flatI = renderer.phong(faceCenter, faceNormal, *poly.material);
+
+    } else if (mode == ShadingMode::Gouraud) {
+        // só os vértices que ainda não vieram iluminados do cache
+        for (auto& v : poly.verts) {
+            if (v.intensity != INTENSITY_UNLIT) continue;
+            glm::vec3 pos3D(v.x, v.y, v.z);
+            v.intensity = renderer.phong(pos3D, v.normal, *poly.material);
+        }
+    }
+
+    if (mode == ShadingMode::Deferred)
+        visibility.submit(poly, fb);
+    else
+        binner.submit(poly, flatI);
+}
+
+void SceneRenderer::drawShapes(Shapes& shapes, const FrameTransform& frame,
+                               Renderer& renderer, Framebuffer& fb,
+                               SlotHandle highlight) {
+    // os polígonos vão para os tiles e são rasterizados em paralelo no flush
+    begin(fb);
+    {
+        ProfileScope timer(profiler, ProfileStage::Project);
+        shapes.visible(frame, visibleShapes);
+    }
+    for (SlotHandle handle : visibleShapes) {
+        auto& s = shapes.objects[handle];
+        ProfileScope projectTimer(profiler, ProfileStage::Project);
+
+        // a BVH testa caixas folgadas; os bounds justos confirmam (fora
+        // do frustum: nenhum vértice é projetado)
+        if (!Camera::inFrustum(frame, s.bounds)) continue;
+
+        // Salvar material original
+        Material originalMaterial = s.material;
+
+        // Aplicar highlight no shape selecionado (amarelo/laranja brilhante)
+        bool isSelected = (handle == highlight);
+        if (isSelected) {
+            // Misturar cor original com amarelo forte para highlight visível
+            s.material.color.r = std::min(255, (int)s.material.color.r + 150);
+            s.material.color.g = std::min(255, (int)s.material.color.g + 150);
+            s.material.color.b = std::max(0, (int)s.material.color.b - 50); // Reduzir azul para dar tom amarelado
+        }
+        // tabelas do fast math para o material como vai ser desenhado
+        renderer.prepareMaterial(s.material);
+
+        // nível de detalhe pelo tamanho do objeto na tela
+        const MeshLevel& lvl = s.level(s.selectLod(Camera::screenRadius(frame, s.bounds)));
+        const Polyhedron& mesh = lvl.mesh;
+
+        // mesh compartilhado em espaço do objeto: o model entra aqui
+        FrameTransform inst = Camera::instanceTransform(frame, s.model);
+        project_stream(lvl.stream, inst, vertexCache);
+        // Gouraud: intensidade por vértice, guardada no shape entre
+        // frames; as faces só copiam
+        if (renderer.shadingMode() == ShadingMode::Gouraud)
+            s.lightVertices(frame, renderer, vertexCache);
+        projectTimer.stop();
+
+        ProfileScope clipTimer(profiler, ProfileStage::Clip);
+        bool cull = !s.material.doubleSided;
+        for (int f = 0; f < mesh.faceCount(); ++f) {
+            // backface culling antes de montar/recortar a face
+            if (cull && Camera::backFacing(inst, mesh.facePlanes[f])) {
+                frameStats.polygonsCulled++;
+                continue;
+            }
+
+            Face face = mesh.face(f);
+            Polygon poly2D = Camera::assembleAndClip(inst, mesh, face, vertexCache, arena);
+            // material é da instância, não do mesh
+            poly2D.material = &s.material;
+            submit(poly2D, renderer, fb);
+        }
+        clipTimer.stop();
+
+        // Restaurar material original após desenho
+        if (isSelected) {
+            s.material = originalMaterial;
+        }
+    }
+
+    ProfileScope fillTimer(profiler, ProfileStage::Fill);
+    flush(fb, renderer);
+}
+
+void SceneRenderer::drawPolyhedron(const Polyhedron& poly,
+                                   const FrameTransform& frame,
+                                   Renderer& renderer, Framebuffer& fb) {
+    begin(fb);
+    Camera::projectVerts(frame, poly, vertexCache);
+    // sem cache de iluminação: no Gouraud cada face ilumina seus vértices
+    for (auto& v : vertexCache.verts) v.intensity = INTENSITY_UNLIT;
+
+    for (int f = 0; f < poly.faceCount(); ++f) {
+        if (Camera::backFacing(frame, poly.facePlanes[f])) {
+            frameStats.polygonsCulled++;
+            continue;
+        }
+
+        Face face = poly.face(f);
+        Polygon poly2D = Camera::assembleAndClip(frame, poly, face, vertexCache, arena);
+        submit(poly2D, renderer, fb);
+    }
+    flush(fb, renderer);
+}
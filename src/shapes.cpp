@@ -1,5 +1,7 @@
 #include "../include/shapes.h"
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <glm/gtc/matrix_transform.hpp>
 
 #ifndef M_PI
@@ -7,15 +9,133 @@
 #endif
 
 
-Shape::Shape(const Polyhedron& p) : mesh(p) {}
+// ------------------------- MESH -------------------------
+
+MeshData::MeshData(const Polyhedron& p) {
+    addLevel(p, std::numeric_limits<float>::infinity());
+    bounds = computeBounds(levels[0].mesh);
+}
+
+void MeshData::addLevel(const Polyhedron& p, float maxRadiusPx) {
+    MeshLevel l;
+    l.mesh = p;
+    updateFacePlanes(l.mesh);
+    l.stream.assign(l.mesh.verts);
+    l.maxRadiusPx = maxRadiusPx;
+    levels.push_back(std::move(l));
+}
+
+// ------------------------- INSTÂNCIA -------------------------
+
+Shape::Shape(std::shared_ptr<const MeshData> d, const Material& m)
+    : data(std::move(d)), material(m), bounds(data->bounds) {}
+
+Shape::Shape(const Polyhedron& p)
+    : Shape(std::make_shared<const MeshData>(p), p.material) {}
 
 void Shape::applyMatrix(const glm::mat4& M) {
-    for (auto& v : mesh.verts) {
-        glm::vec4 p = M * glm::vec4(v.position, 1.0f);
-        v.position = glm::vec3(p);
+    model = M * model;
+    bounds = transformBounds(data->bounds, model);
+    lighting.dirty = true;
+}
+
+// mesma view e projeção: os vértices caem nos mesmos pixels/profundidades
+static bool sameProjection(const FrameTransform& a, const FrameTransform& b) {
+    return a.view == b.view && a.ortho == b.ortho && a.sx == b.sx &&
+           a.sy == b.sy && a.nearp == b.nearp && a.farp == b.farp &&
+           a.W == b.W && a.H == b.H;
+}
+
+void Shape::lightVertices(const FrameTransform& frame, const Renderer& renderer,
+                          VertexCache& cache) {
+    size_t n = cache.verts.size();
+
+    if (lighting.dirty || lighting.level != lod ||
+        lighting.lightVersion != renderer.lightingVersion() ||
+        lighting.intensity.size() != n ||
+        !sameProjection(lighting.frame, frame)) {
+        lighting.intensity.resize(n);
+        for (size_t i = 0; i < n; i++) {
+            // fora do guard band x/y/z não valem; a face passa pelo recorte
+            // em clip space e é iluminada depois
+            if (cache.outcode[i] != 0) {
+                lighting.intensity[i] = INTENSITY_UNLIT;
+                continue;
+            }
+            const Vertex2D& v = cache.verts[i];
+            lighting.intensity[i] =
+                renderer.phong(glm::vec3(v.x, v.y, v.z), v.normal, material);
+        }
+
+        lighting.dirty = false;
+        lighting.level = lod;
+        lighting.lightVersion = renderer.lightingVersion();
+        lighting.frame = frame;
+    }
+
+    for (size_t i = 0; i < n; i++) cache.verts[i].intensity = lighting.intensity[i];
+}
+
+glm::vec3 Shape::center() const {
+    return glm::vec3(model * glm::vec4(data->bounds.center, 1.0f));
+}
+
+int Shape::selectLod(float radiusPx) {
+    // o nível mais grosso que aguenta o raio; para engrossar o raio tem
+    // que ficar uma folga abaixo do limite, para voltar a refinar uma
+    // folga acima
+    int k = (int)data->levels.size() - 1;
+    for (; k > 0; k--) {
+        float slack = k > lod ? 1.0f - LOD_HYSTERESIS : 1.0f + LOD_HYSTERESIS;
+        if (radiusPx <= data->levels[k].maxRadiusPx * slack) break;
+    }
+    lod = k;
+    return lod;
+}
+
+Bounds computeBounds(const Polyhedron& mesh) {
+    Bounds b;
+    if (mesh.verts.empty()) return b;
+
+    b.min = b.max = mesh.verts[0].position;
+    for (const auto& v : mesh.verts) {
+        b.min = glm::min(b.min, v.position);
+        b.max = glm::max(b.max, v.position);
+    }
+
+    b.center = (b.min + b.max) * 0.5f;
+    for (const auto& v : mesh.verts)
+        b.radius = std::max(b.radius, glm::length(v.position - b.center));
+    return b;
+}
+
+void updateFacePlanes(Polyhedron& mesh) {
+    mesh.facePlanes.resize(mesh.faceCount());
+
+    for (int f = 0; f < mesh.faceCount(); f++) {
+        Face idx = mesh.face(f);
+        glm::vec3 n(0), c(0), vn(0);
+
+        for (int i = 0; i < idx.size(); i++) {
+            const glm::vec3& a = mesh.verts[idx[i]].position;
+            const glm::vec3& b = mesh.verts[idx[(i + 1) % idx.size()]].position;
+            n.x += (a.y - b.y) * (a.z + b.z);
+            n.y += (a.z - b.z) * (a.x + b.x);
+            n.z += (a.x - b.x) * (a.y + b.y);
+            c += a;
+            vn += mesh.verts[idx[i]].normal;
+        }
+
+        float len = glm::length(n);
+        if (idx.size() < 3 || len < 1e-12f) {
+            mesh.facePlanes[f] = glm::vec4(0);  // degenerada: nunca descarta
+            continue;
+        }
 
-        glm::vec4 n = M * glm::vec4(v.normal, 0.0f);
-        v.normal = glm::normalize(glm::vec3(n));
+        n /= len;
+        if (glm::dot(n, vn) < 0.0f) n = -n;
+        c /= float(idx.size());
+        mesh.facePlanes[f] = glm::vec4(n, -glm::dot(n, c));
     }
 }
 
@@ -94,14 +214,12 @@ static Polyhedron buildCube(Material material) {
     }
 
     // Definir faces (sentido anti-horário quando visto de fora)
-    cube.faces = {
-        {{0, 1, 2, 3}},  // frente  (z = -1)
-        {{5, 4, 7, 6}},  // trás    (z = +1)
-        {{4, 0, 3, 7}},  // esquerda (x = -1)
-        {{1, 5, 6, 2}},  // direita  (x = +1)
-        {{4, 5, 1, 0}},  // baixo    (y = -1)
-        {{3, 2, 6, 7}}   // topo     (y = +1)
-    };
+    cube.addFace({0, 1, 2, 3});  // frente  (z = -1)
+    cube.addFace({5, 4, 7, 6});  // trás    (z = +1)
+    cube.addFace({4, 0, 3, 7});  // esquerda (x = -1)
+    cube.addFace({1, 5, 6, 2});  // direita  (x = +1)
+    cube.addFace({4, 5, 1, 0});  // baixo    (y = -1)
+    cube.addFace({3, 2, 6, 7});  // topo     (y = +1)
 
     cube.material = material;  
 
@@ -121,11 +239,11 @@ static Polyhedron buildPyramid(Material material) {
         {{0, 1, 0}, {0, 0, 0}}  // topo
     };
 
-    p.faces = {{{0, 1, 2, 3}},  // base
-               {{0, 1, 4}},
-               {{1, 2, 4}},
-               {{2, 3, 4}},
-               {{3, 0, 4}}};
+    p.addFace({0, 1, 2, 3});  // base
+    p.addFace({0, 1, 4});
+    p.addFace({1, 2, 4});
+    p.addFace({2, 3, 4});
+    p.addFace({3, 0, 4});
 
     for (auto& v : p.verts) v.normal = glm::normalize(v.position);
 
@@ -149,9 +267,11 @@ static Polyhedron buildCylinder(int slices, Material material) {
     }
 
     // faces laterais
+    p.indices.reserve(slices * 4);
+    p.faceStart.reserve(slices + 1);
     for (int i = 0; i < slices; i++) {
         int i2 = (i + 1) % slices;
-        p.faces.push_back({{i * 2, i2 * 2, i2 * 2 + 1, i * 2 + 1}});
+        p.addFace({i * 2, i2 * 2, i2 * 2 + 1, i * 2 + 1});
     }
 
     p.material = material;
@@ -181,12 +301,14 @@ static Polyhedron buildSphere(int stacks, int slices, Material material) {
 
     int w = slices + 1;
 
+    p.indices.reserve(stacks * slices * 4);
+    p.faceStart.reserve(stacks * slices + 1);
     for (int i = 0; i < stacks; i++) {
         for (int j = 0; j < slices; j++) {
             int a = i * w + j;
             int b = a + w;
 
-            p.faces.push_back({{a, b, b + 1, a + 1}});
+            p.addFace({a, b, b + 1, a + 1});
         }
     }
 
@@ -195,37 +317,189 @@ static Polyhedron buildSphere(int stacks, int slices, Material material) {
 }
 
 
-Shape& Shapes::createCube(Material material, const glm::vec3& center, float size) {
-    Shape obj(buildCube(material));
+SlotHandle Shapes::add(const Polyhedron& p) {
+    return add(Shape(p));
+}
+
+SlotHandle Shapes::add(const Shape& s) {
+    SlotHandle h = objects.insert(s);
+    Shape& obj = objects[h];
+    obj.proxy = bvh.insert((int)h.index, obj.bounds);
+    return h;
+}
+
+void Shapes::remove(SlotHandle h) {
+    if (!objects.contains(h)) return;
+    bvh.remove(objects[h].proxy);
+    objects.remove(h);
+}
+
+void Shapes::refit(SlotHandle h) {
+    bvh.update(objects[h].proxy, objects[h].bounds);
+}
+
+void Shapes::visible(const FrameTransform& ft, std::vector<SlotHandle>& out) const {
+    out.clear();
+    bvh.queryFrustum(ft, [&](int slot) { out.push_back(objects.handleOfSlot(slot)); });
+    // o resultado não depende da forma da árvore
+    std::sort(out.begin(), out.end(), [](const SlotHandle& a, const SlotHandle& b) {
+        return a.index < b.index;
+    });
+}
+
+SlotHandle Shapes::pick(const glm::vec3& origin, const glm::vec3& dir) const {
+    SlotHandle best;
+    bvh.raycast(origin, dir, std::numeric_limits<float>::infinity(),
+                [&](int slot, float tMax) {
+                    // raio no espaço do objeto: com dir sem normalizar, o t
+                    // é o mesmo do raio de mundo
+                    SlotHandle h = objects.handleOfSlot(slot);
+                    const Shape& s = objects[h];
+                    glm::mat4 inv = glm::inverse(s.model);
+                    glm::vec3 o(inv * glm::vec4(origin, 1.0f));
+                    glm::vec3 d(inv * glm::vec4(dir, 0.0f));
+
+                    float t;
+                    if (!intersectRay(s.level(0).mesh, o, d, tMax, t))
+                        return tMax;
+                    best = h;
+                    return t;
+                });
+    return best;
+}
+
+bool intersectRay(const Polyhedron& mesh, const glm::vec3& origin,
+                  const glm::vec3& dir, float tMax, float& t) {
+    bool hit = false;
+    for (int fi = 0; fi < mesh.faceCount(); fi++) {
+        Face f = mesh.face(fi);
+        if (f.size() < 3) continue;
+        const glm::vec3& a = mesh.verts[f[0]].position;
+
+        // Möller–Trumbore em cada triângulo do leque (a, b, c)
+        for (int k = 1; k + 1 < f.size(); k++) {
+            const glm::vec3& b = mesh.verts[f[k]].position;
+            const glm::vec3& c = mesh.verts[f[k + 1]].position;
+            glm::vec3 e1 = b - a, e2 = c - a;
+            glm::vec3 p = glm::cross(dir, e2);
+            float det = glm::dot(e1, p);
+            if (std::fabs(det) < 1e-12f) continue;  // raio paralelo
+
+            float inv = 1.0f / det;
+            glm::vec3 s = origin - a;
+            float u = glm::dot(s, p) * inv;
+            if (u < 0.0f || u > 1.0f) continue;
+            glm::vec3 q = glm::cross(s, e1);
+            float v = glm::dot(dir, q) * inv;
+            if (v < 0.0f || u + v > 1.0f) continue;
+
+            float d = glm::dot(e2, q) * inv;
+            if (d > 0.0f && d < tMax) {
+                tMax = t = d;
+                hit = true;
+            }
+        }
+    }
+    return hit;
+}
+
+// níveis gerados dividem as fatias por 1.5 até este mínimo
+static constexpr int LOD_MIN_SLICES = 4;
+
+// maior raio (px) em que a corda de um círculo com `slices` lados fica a
+// menos de LOD_ERROR_PX do arco (flecha r * (1 - cos(pi / slices)))
+static float lodMaxRadius(int slices) {
+    return LOD_ERROR_PX / float(1.0 - std::cos(M_PI / slices));
+}
+
+std::shared_ptr<const MeshData> Shapes::sharedMesh(ShapeType type, int a, int b) {
+    auto& slot = meshes[{type, a, b}];
+    if (slot) return slot;
+
+    std::shared_ptr<MeshData> m;
+    switch (type) {
+    case ShapeType::Cube:
+        m = std::make_shared<MeshData>(buildCube(Material{}));
+        break;
+    case ShapeType::Pyramid:
+        m = std::make_shared<MeshData>(buildPyramid(Material{}));
+        break;
+    case ShapeType::Cylinder:  // a = fatias
+        m = std::make_shared<MeshData>(buildCylinder(a, Material{}));
+        for (int sl = a * 2 / 3; sl >= LOD_MIN_SLICES; sl = sl * 2 / 3)
+            m->addLevel(buildCylinder(sl, Material{}), lodMaxRadius(sl));
+        break;
+    case ShapeType::Sphere:  // a = stacks, b = fatias
+        m = std::make_shared<MeshData>(buildSphere(a, b, Material{}));
+        for (int sl = b * 2 / 3; sl >= LOD_MIN_SLICES; sl = sl * 2 / 3) {
+            int st = std::max(2, a * sl / b);
+            m->addLevel(buildSphere(st, sl, Material{}), lodMaxRadius(sl));
+        }
+        break;
+    }
+    slot = m;
+    return slot;
+}
+
+SlotHandle Shapes::createCube(Material material, const glm::vec3& center, float size) {
+    Shape obj(sharedMesh(ShapeType::Cube), material);
     obj.scale(size * 0.5f);
     obj.translate(center);
-    objects.push_back(obj);
-    return objects.back();
+    return add(obj);
 }
 
-Shape& Shapes::createPyramid(Material material, const glm::vec3& center,
+SlotHandle Shapes::createPyramid(Material material, const glm::vec3& center,
                                 float size, float height) {
-    Shape obj(buildPyramid(material));
+    Shape obj(sharedMesh(ShapeType::Pyramid), material);
     obj.scale({size * 0.5f, height * 0.5f, size * 0.5f});
     obj.translate(center);
-    objects.push_back(obj);
-    return objects.back();
+    return add(obj);
 }
 
-Shape& Shapes::createCylinder(Material material, const glm::vec3& c, float r, float h,
+SlotHandle Shapes::createCylinder(Material material, const glm::vec3& c, float r, float h,
                                 int slices) {
-    Shape obj(buildCylinder(slices, material));
+    // tubo aberto (sem tampas): o lado de dentro aparece pelas pontas
+    material.doubleSided = true;
+    Shape obj(sharedMesh(ShapeType::Cylinder, slices), material);
     obj.scale({r, h * 0.5f, r});
     obj.translate(c);
-    objects.push_back(obj);
-    return objects.back();
+    return add(obj);
 }
 
-Shape& Shapes::createSphere(Material material, const glm::vec3& c, float r, int stacks,
+SlotHandle Shapes::createSphere(Material material, const glm::vec3& c, float r, int stacks,
                             int slices) {
-    Shape obj(buildSphere(stacks, slices, material));
+    Shape obj(sharedMesh(ShapeType::Sphere, stacks, slices), material);
     obj.scale(r);
     obj.translate(c);
-    objects.push_back(obj);
-    return objects.back();
+    return add(obj);
+}
+
+Bounds transformBounds(const Bounds& b, const glm::mat4& M) {
+    Bounds r;
+
+    // AABB (Arvo): envolve a caixa transformada
+    glm::vec3 lo(M[3]), hi(M[3]);
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            float x = M[j][i] * b.min[j];
+            float y = M[j][i] * b.max[j];
+            lo[i] += std::min(x, y);
+            hi[i] += std::max(x, y);
+        }
+    }
+    r.min = lo;
+    r.max = hi;
+
+    // esfera: o raio escala pelo maior valor singular da parte linear, aqui
+    // limitado por Gershgorin em MᵀM (exato para rotação/escala por eixo)
+    float s2 = 0.0f;
+    for (int i = 0; i < 3; i++) {
+        float row = 0.0f;
+        for (int j = 0; j < 3; j++)
+            row += std::fabs(glm::dot(glm::vec3(M[i]), glm::vec3(M[j])));
+        s2 = std::max(s2, row);
+    }
+    r.center = glm::vec3(M * glm::vec4(b.center, 1.0f));
+    r.radius = b.radius * std::sqrt(s2);
+    return r;
 }
@@ -0,0 +1,345 @@
+#include "../include/span_shading.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "../include/simd_lanes.h"
+
+#ifdef SIMD_LANES
+
+// ------------------------- MATH (ln / exp) -------------------------
+// Aproximações polinomiais do Cephes (erro relativo ~1e-7), usadas para
+// pow(x, s) = exp(s * ln(x)) no especular.
+
+static inline vf vlog(vf x) {
+    x = vmax(x, vset(1.17549435e-38f));  // menor normal positivo
+
+    vi e = ishr<23>(vasi(x));
+    x = iasv(ior(iand(vasi(x), iset(~0x7f800000)), vasi(vset(0.5f))));
+
+    vf ef = vadd(itov(isub(e, iset(0x7f))), vset(1.0f));
+
+    // mantissa em [sqrt(.5), sqrt(2)) para o polinômio convergir melhor
+    vf m = vlt(x, vset(0.707106781186547524f));
+    vf t = vand(x, m);
+    x = vsub(x, vset(1.0f));
+    ef = vsub(ef, vand(vset(1.0f), m));
+    x = vadd(x, t);
+
+    vf z = vmul(x, x);
+    vf y = vset(7.0376836292E-2f);
+    y = vadd(vmul(y, x), vset(-1.1514610310E-1f));
+    y = vadd(vmul(y, x), vset(1.1676998740E-1f));
+    y = vadd(vmul(y, x), vset(-1.2420140846E-1f));
+    y = vadd(vmul(y, x), vset(1.4249322787E-1f));
+    y = vadd(vmul(y, x), vset(-1.6668057665E-1f));
+    y = vadd(vmul(y, x), vset(2.0000714765E-1f));
+    y = vadd(vmul(y, x), vset(-2.4999993993E-1f));
+    y = vadd(vmul(y, x), vset(3.3333331174E-1f));
+    y = vmul(vmul(y, x), z);
+
+    y = vadd(y, vmul(ef, vset(-2.12194440e-4f)));
+    y = vsub(y, vmul(z, vset(0.5f)));
+    x = vadd(x, y);
+    return vadd(x, vmul(ef, vset(0.693359375f)));
+}
+
+static inline vf vexp(vf x) {
+    x = vmin(x, vset(88.3762626647949f));
+    x = vmax(x, vset(-88.3762626647949f));
+
+    // n = floor(x / ln2 + 0.5)
+    vf fx = vadd(vmul(x, vset(1.44269504088896341f)), vset(0.5f));
+    vf tr = itov(vtoi(fx));
+    fx = vsub(tr, vand(vgt(tr, fx), vset(1.0f)));
+
+    x = vsub(x, vmul(fx, vset(0.693359375f)));
+    x = vsub(x, vmul(fx, vset(-2.12194440e-4f)));
+
+    vf z = vmul(x, x);
+    vf y = vset(1.9875691500E-4f);
+    y = vadd(vmul(y, x), vset(1.3981999507E-3f));
+    y = vadd(vmul(y, x), vset(8.3334519073E-3f));
+    y = vadd(vmul(y, x), vset(4.1665795894E-2f));
+    y = vadd(vmul(y, x), vset(1.6666665459E-1f));
+    y = vadd(vmul(y, x), vset(5.0000001201E-1f));
+    y = vadd(vadd(vmul(y, z), x), vset(1.0f));
+
+    vi n = ishl<23>(iadd(vtoi(fx), iset(0x7f)));
+    return vmul(y, iasv(n));
+}
+
+// ------------------------- KERNEL -------------------------
+
+// ShadingTable::shaded é lido como cor empacotada
+static_assert(sizeof(Color) == sizeof(uint32_t), "Color deve ter 4 bytes");
+
+// constantes do span já espalhadas nas lanes
+struct span_consts {
+    float x0, y;
+
+    float z, dz, i, di;
+    glm::vec3 n, dn;
+
+    vf cr, cg, cb;  // cor do material
+    vi alpha;       // alpha já deslocado para o byte alto
+
+    float ka, kd, ks, shininess, li;
+    glm::vec3 lightPos, eye;
+
+    vi flatColor;   // modo Flat: cor constante
+
+    // fast math (ShadingTable)
+    const float* spec;
+    const uint32_t* shaded;  // Color empacotada como no Framebuffer
+};
+
+static inline vf vdot(vf ax, vf ay, vf az, vf bx, vf by, vf bz) {
+    return vadd(vadd(vmul(ax, bx), vmul(ay, by)), vmul(az, bz));
+}
+
+template <bool FAST>
+static inline void vnormalize(vf& x, vf& y, vf& z) {
+    vf d = vdot(x, y, z, x, y, z);
+    if constexpr (FAST) {
+        // rsqrt + um passo de Newton: erro relativo ~1e-6, sem sqrt/div
+        vf r = vrsqrt(d);
+        r = vmul(r, vsub(vset(1.5f), vmul(vmul(vset(0.5f), d), vmul(r, r))));
+        x = vmul(x, r);
+        y = vmul(y, r);
+        z = vmul(z, r);
+    } else {
+        vf len = vsqrt(d);
+        x = vdiv(x, len);
+        y = vdiv(y, len);
+        z = vdiv(z, len);
+    }
+}
+
+// ShadingTable::specular nas lanes (nh >= 0)
+static inline vf spec_lut(const span_consts& k, vf nh) {
+    const int N = ShadingTable::SPEC_SIZE;
+    vf f = vmul(vmin(nh, vset(1.0f)), vset(float(N)));
+    vi i = vtoi(vmin(f, vset(float(N - 1))));
+    vf a = vgather(k.spec, i);
+    vf b = vgather(k.spec, iadd(i, iset(1)));
+    return vadd(a, vmul(vsub(b, a), vsub(f, itov(i))));
+}
+
+// mesma conta do Renderer::phong (FAST: phongFast), com pos = (x, y, z) em
+// screen-space
+template <bool FAST>
+static inline vf phong_lanes(const span_consts& k, vf t, vf px, vf pz) {
+    vf nx = vadd(vset(k.n.x), vmul(vset(k.dn.x), t));
+    vf ny = vadd(vset(k.n.y), vmul(vset(k.dn.y), t));
+    vf nz = vadd(vset(k.n.z), vmul(vset(k.dn.z), t));
+    vnormalize<FAST>(nx, ny, nz);
+
+    vf py = vset(k.y);
+
+    vf lx = vsub(vset(k.lightPos.x), px);
+    vf ly = vsub(vset(k.lightPos.y), py);
+    vf lz = vsub(vset(k.lightPos.z), pz);
+    vnormalize<FAST>(lx, ly, lz);
+
+    vf ex = vsub(vset(k.eye.x), px);
+    vf ey = vsub(vset(k.eye.y), py);
+    vf ez = vsub(vset(k.eye.z), pz);
+    vnormalize<FAST>(ex, ey, ez);
+
+    vf hx = vadd(lx, ex), hy = vadd(ly, ey), hz = vadd(lz, ez);
+    vnormalize<FAST>(hx, hy, hz);
+
+    vf zero = vset(0.0f);
+    vf diff = vmax(vdot(nx, ny, nz, lx, ly, lz), zero);
+    vf nh = vmax(vdot(nx, ny, nz, hx, hy, hz), zero);
+
+    vf spec;
+    if constexpr (FAST)
+        spec = spec_lut(k, nh);
+    else
+        spec = vexp(vmul(vset(k.shininess), vlog(nh)));
+    spec = vsel(vgt(diff, zero), spec, zero);
+
+    vf li = vset(k.li);
+    vf I = vadd(vset(k.ka), vmul(vmul(vset(k.kd), diff), li));
+    I = vadd(I, vmul(vmul(vset(k.ks), spec), li));
+    return vmin(vmax(I, zero), vset(1.0f));
+}
+
+// mesmo empacotamento do Framebuffer::pack (RGBA little-endian); FAST lê
+// a cor pronta de ShadingTable::shaded
+template <bool FAST>
+static inline vi pack_lanes(const span_consts& k, vf I) {
+    vf zero = vset(0.0f), top = vset(255.0f);
+    if constexpr (FAST) {
+        vf q = vadd(vmul(vmin(vmax(I, zero), vset(1.0f)), top), vset(0.5f));
+        return igather(k.shaded, vtoi(q));
+    }
+    vi r = vtoi(vmin(vmax(vmul(k.cr, I), zero), top));
+    vi g = vtoi(vmin(vmax(vmul(k.cg, I), zero), top));
+    vi b = vtoi(vmin(vmax(vmul(k.cb, I), zero), top));
+    return ior(ior(r, ishl<8>(g)), ior(ishl<16>(b), k.alpha));
+}
+
+// processa SIMD_LANES pixels a partir de x (zp/cp apontam para o pixel x);
+// devolve a máscara das lanes escritas
+template <ShadingMode M, bool FAST>
+static int shade_lanes(const span_consts& k, int x, float* zp, uint32_t* cp) {
+    vf t = vadd(vset(float(x) - k.x0), vlane());
+    vf z = vadd(vset(k.z), vmul(vset(k.dz), t));
+
+    vf zbuf = vload(zp);
+    vf pass = vlt(z, zbuf);
+    int bits = vmask(pass);
+    if (bits == 0) return 0;  // tudo oculto: nada para iluminar
+
+    vi color;
+    if constexpr (M == ShadingMode::Flat) {
+        color = k.flatColor;
+    } else if constexpr (M == ShadingMode::Gouraud) {
+        color = pack_lanes<FAST>(k, vadd(vset(k.i), vmul(vset(k.di), t)));
+    } else {
+        vf px = vadd(vset(float(x)), vlane());
+        color = pack_lanes<FAST>(k, phong_lanes<FAST>(k, t, px, z));
+    }
+
+    vstore(zp, vsel(pass, z, zbuf));
+    istore(cp, vasi(vsel(pass, iasv(color), iasv(iload(cp)))));
+    return bits;
+}
+
+// conta as lanes escritas e, com overdraw ligado, soma 1 em cada pixel
+// (só até a lane escrita mais alta: no resto do span as outras não existem)
+static int count_lanes(int bits, uint16_t* overdraw) {
+    if (overdraw)
+        for (int i = 0; (bits >> i) != 0; i++) overdraw[i] += (bits >> i) & 1;
+
+    int written = 0;
+    for (; bits; bits &= bits - 1) written++;
+    return written;
+}
+
+template <ShadingMode M, bool FAST>
+static int shade_row(const span_consts& k, const Span& s, Framebuffer& fb,
+                     RasterStats* stats) {
+    float* zrow = fb.depthRow(s.y);
+    uint32_t* crow = fb.colorRow(s.y);
+    uint16_t* orow = fb.overdrawRow(s.y);
+
+    int written = 0;
+    int shaded = 0;  // lanes com cor calculada (grupo com alguma lane visível)
+    int x = s.x0;
+    for (; x + SIMD_LANES - 1 <= s.x1; x += SIMD_LANES) {
+        int bits = shade_lanes<M, FAST>(k, x, zrow + x, crow + x);
+        if (bits) {
+            shaded += SIMD_LANES;
+            written += count_lanes(bits, orow ? orow + x : nullptr);
+        }
+    }
+
+    // resto do span: lanes extras com depth -inf nunca passam no z-test
+    int rest = s.x1 - x + 1;
+    if (rest > 0) {
+        float zt[SIMD_LANES];
+        uint32_t ct[SIMD_LANES] = {};
+        std::fill(zt, zt + SIMD_LANES, -std::numeric_limits<float>::infinity());
+        std::memcpy(zt, zrow + x, rest * sizeof(float));
+        std::memcpy(ct, crow + x, rest * sizeof(uint32_t));
+
+        int bits = shade_lanes<M, FAST>(k, x, zt, ct);
+        if (bits) shaded += rest;
+        written += count_lanes(bits, orow ? orow + x : nullptr);
+
+        std::memcpy(zrow + x, zt, rest * sizeof(float));
+        std::memcpy(crow + x, ct, rest * sizeof(uint32_t));
+    }
+    if (stats) stats->pixelsShaded += shaded;
+    return written;
+}
+
+template <ShadingMode M>
+int shade_span(const Span& s, const Material& mat, const Renderer& renderer,
+               Framebuffer& fb, RasterStats* stats)
+{
+    if (s.x0 > s.x1) return 0;
+
+    const Light& light = renderer.getLight();
+
+    span_consts k;
+    k.x0 = float(s.x0);
+    k.y = float(s.y);
+    k.z = s.z;
+    k.dz = s.dz;
+    if constexpr (M == ShadingMode::Gouraud) {
+        k.i = s.i;
+        k.di = s.di;
+    }
+    if constexpr (M == ShadingMode::Phong) {
+        k.n = s.n;
+        k.dn = s.dn;
+    }
+    k.cr = vset(float(mat.color.r));
+    k.cg = vset(float(mat.color.g));
+    k.cb = vset(float(mat.color.b));
+    k.alpha = iset(int(uint32_t(mat.color.a) << 24));
+    k.ka = mat.ka;
+    k.kd = mat.kd;
+    k.ks = mat.ks;
+    k.shininess = mat.shininess;
+    k.li = light.intensity;
+    k.lightPos = light.pos;
+    k.eye = renderer.cameraEye();
+
+    if (const ShadingTable* t = renderer.fastTable(mat)) {
+        k.spec = t->spec;
+        k.shaded = reinterpret_cast<const uint32_t*>(t->shaded);
+        if constexpr (M == ShadingMode::Flat)
+            k.flatColor = pack_lanes<true>(k, vset(renderer.flatIntensity()));
+        return shade_row<M, true>(k, s, fb, stats);
+    }
+
+    if constexpr (M == ShadingMode::Flat)
+        k.flatColor = pack_lanes<false>(k, vset(renderer.flatIntensity()));
+    return shade_row<M, false>(k, s, fb, stats);
+}
+
+#else  // sem SIMD: mesmo resultado, um pixel por vez
+
+template <ShadingMode M>
+int shade_span(const Span& s, const Material& mat, const Renderer& renderer,
+               Framebuffer& fb, RasterStats* stats)
+{
+    int written = 0;
+    for (int x = s.x0; x <= s.x1; x++) {
+        float t = float(x - s.x0);
+        float z = s.z + s.dz * t;
+        if (!(z < fb.depth(x, s.y))) continue;
+
+        glm::vec3 pos(x, s.y, z);
+        Color c;
+        if constexpr (M == ShadingMode::Flat)
+            c = renderer.shade<M>(mat, 0.0f, s.n, pos);
+        else if constexpr (M == ShadingMode::Gouraud)
+            c = renderer.shade<M>(mat, s.i + s.di * t, s.n, pos);
+        else
+            c = renderer.shade<M>(mat, 0.0f, s.n + s.dn * t, pos);
+        written += fb.set(x, s.y, z, c);
+    }
+    // aqui o z-test vem antes da cor: só quem passa é iluminado
+    if (stats) stats->pixelsShaded += written;
+    return written;
+}
+
+#endif
+
+template int shade_span<ShadingMode::Flat>(const Span&, const Material&,
+                                           const Renderer&, Framebuffer&,
+                                           RasterStats*);
+template int shade_span<ShadingMode::Gouraud>(const Span&, const Material&,
+                                              const Renderer&, Framebuffer&,
+                                              RasterStats*);
+template int shade_span<ShadingMode::Phong>(const Span&, const Material&,
+                                            const Renderer&, Framebuffer&,
+                                            RasterStats*);
@@ -0,0 +1,60 @@
+#include "../include/thread_pool.h"
+
+ThreadPool::ThreadPool(int threads) {
+    if (threads <= 0) threads = (int)std::thread::hardware_concurrency();
+    if (threads <= 0) threads = 1;
+
+    workers.reserve(threads);
+    for (int i = 0; i < threads; i++)
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lk(m);
+        quit = true;
+    }
+    cvWork.notify_all();
+    for (auto& t : workers) t.join();
+}
+
+void ThreadPool::run(int count, const std::function<void(int, int)>& fn) {
+    if (count <= 0) return;
+
+    {
+        std::lock_guard<std::mutex> lk(m);
+        job = &fn;
+        jobCount = count;
+        nextItem = 0;
+        busy = (int)workers.size();
+        ++generation;
+    }
+    cvWork.notify_all();
+
+    std::unique_lock<std::mutex> lk(m);
+    cvDone.wait(lk, [&] { return busy == 0; });
+    job = nullptr;
+}
+
+void ThreadPool::workerLoop(int worker) {
+    uint64_t seen = 0;
+
+    for (;;) {
+        const std::function<void(int, int)>* fn;
+        int count;
+        {
+            std::unique_lock<std::mutex> lk(m);
+            cvWork.wait(lk, [&] { return quit || generation != seen; });
+            if (quit) return;
+            seen = generation;
+            fn = job;
+            count = jobCount;
+        }
+
+        // itens distribuídos dinamicamente: quem termina antes pega mais
+        for (int i = nextItem++; i < count; i = nextItem++) (*fn)(i, worker);
+
+        std::lock_guard<std::mutex> lk(m);
+        if (--busy == 0) cvDone.notify_one();
+    }
+}
@@ -0,0 +1,97 @@
+#include "../include/tile_raster.h"
+
+#include <algorithm>
+
+void TileBinner::begin(int w, int h) {
+    W = w;
+    H = h;
+    tilesX = (W + TILE - 1) / TILE;
+    tilesY = (H + TILE - 1) / TILE;
+
+    if ((int)bins.size() != tilesX * tilesY) bins.resize(tilesX * tilesY);
+    for (auto& b : bins) b.clear();
+    verts.clear();
+    count = 0;
+}
+
+void TileBinner::submit(const Polygon& p, float flatI) {
+    if (p.verts.size() < 3 || !p.material) return;
+
+    int minX = p.verts[0].x, maxX = minX;
+    int minY = p.verts[0].y, maxY = minY;
+    for (const auto& v : p.verts) {
+        minX = std::min(minX, v.x);
+        maxX = std::max(maxX, v.x);
+        minY = std::min(minY, v.y);
+        maxY = std::max(maxY, v.y);
+    }
+
+    minX = std::max(minX, 0);
+    minY = std::max(minY, 0);
+    maxX = std::min(maxX, W - 1);
+    maxY = std::min(maxY, H - 1);
+    if (minX > maxX || minY > maxY) return;
+
+    if (count == (int)polys.size()) {
+        polys.emplace_back();
+        vertStart.emplace_back();
+        materials.emplace_back();
+        flatIs.emplace_back();
+    }
+
+    int id = count++;
+    vertStart[id] = (int)verts.size();
+    verts.insert(verts.end(), p.verts.begin(), p.verts.end());
+    polys[id].verts.n = p.verts.size();
+    materials[id] = *p.material;
+    flatIs[id] = flatI;
+
+    for (int ty = minY / TILE; ty <= maxY / TILE; ty++)
+        for (int tx = minX / TILE; tx <= maxX / TILE; tx++)
+            bins[ty * tilesX + tx].push_back(id);
+}
+
+void TileBinner::flush(Framebuffer& fb, const Renderer& renderer) {
+    if (count == 0) return;
+
+    // vértices e materiais só param de mudar de endereço depois do último
+    // submit
+    for (int i = 0; i < count; i++) {
+        polys[i].verts.ptr = verts.data() + vertStart[i];
+        polys[i].material = &materials[i];
+    }
+
+    if ((int)contexts.size() < pool.size()) contexts.resize(pool.size());
+
+    pool.parallelFor(tilesX * tilesY, [&](int tile, int worker) {
+        const auto& bin = bins[tile];
+        if (bin.empty()) return;
+
+        int tx = tile % tilesX;
+        int ty = tile / tilesX;
+
+        RasterContext& ctx = contexts[worker];
+        ctx.clip.x0 = tx * TILE;
+        ctx.clip.y0 = ty * TILE;
+        ctx.clip.x1 = std::min(ctx.clip.x0 + TILE, W) - 1;
+        ctx.clip.y1 = std::min(ctx.clip.y0 + TILE, H) - 1;
+
+        // cópia local: a intensidade Flat muda por polígono
+        Renderer local = renderer;
+        for (int id : bin) {
+            local.setFlatIntensity(flatIs[id]);
+            fill_polygon(polys[id], fb, local, ctx);
+        }
+    });
+
+    for (auto& b : bins) b.clear();
+    verts.clear();
+    count = 0;
+}
+
+void TileBinner::takeStats(RasterStats& out) {
+    for (auto& ctx : contexts) {
+        out.add(ctx.stats);
+        ctx.stats = RasterStats();
+    }
+}
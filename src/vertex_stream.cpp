@@ -0,0 +1,142 @@
+#include "../include/vertex_stream.h"
+
+#include <cmath>
+
+#include "../include/simd_lanes.h"
+
+// ------------------------- AoS -> SoA -------------------------
+
+void VertexStream::assign(const std::vector<Vertex3D>& verts) {
+    size_t n = verts.size();
+    px.resize(n); py.resize(n); pz.resize(n);
+    nx.resize(n); ny.resize(n); nz.resize(n);
+
+    for (size_t i = 0; i < n; i++) {
+        px[i] = verts[i].position.x;
+        py[i] = verts[i].position.y;
+        pz[i] = verts[i].position.z;
+        nx[i] = verts[i].normal.x;
+        ny[i] = verts[i].normal.y;
+        nz[i] = verts[i].normal.z;
+    }
+}
+
+// ------------------------- ESCALAR -------------------------
+// usado no resto (n % SIMD_LANES) e quando não há SIMD
+
+static void project_one(const VertexStream& s, size_t i,
+                        const FrameTransform& ft, VertexCache& cache) {
+    Vertex2D& o = cache.verts[i];
+    cache.outcode[i] = Camera::clipVertex(
+        ft, glm::vec3(s.px[i], s.py[i], s.pz[i]), cache.clip[i]);
+    if (cache.outcode[i] == 0) Camera::toScreen(ft, cache.clip[i], o);
+    o.normal = ft.normalMatrix * glm::vec3(s.nx[i], s.ny[i], s.nz[i]);
+    o.intensity = 1.0f;
+}
+
+static void resize_cache(VertexCache& cache, size_t n) {
+    cache.verts.resize(n);
+    cache.clip.resize(n);
+    cache.outcode.resize(n);
+}
+
+#ifdef SIMD_LANES
+
+// ------------------------- LOTES -------------------------
+
+// linha r de M aplicada a (x, y, z, w), somando aos pares como o glm
+static inline vf mrow(const glm::mat4& M, int r, vf x, vf y, vf z, float w) {
+    vf a = vadd(vmul(vset(M[0][r]), x), vmul(vset(M[1][r]), y));
+    vf b = vmul(vset(M[2][r]), z);
+    if (w != 0.0f) b = vadd(b, vset(M[3][r] * w));
+    return vadd(a, b);
+}
+
+static inline vf nrow(const glm::mat3& M, int r, vf x, vf y, vf z) {
+    return vadd(vadd(vmul(vset(M[0][r]), x), vmul(vset(M[1][r]), y)),
+                vmul(vset(M[2][r]), z));
+}
+
+void project_stream(const VertexStream& s, const FrameTransform& ft,
+                    VertexCache& cache) {
+    size_t n = s.size();
+    resize_cache(cache, n);
+
+    const glm::mat4& V = ft.view;
+    const vf zero = vset(0.0f), half = vset(0.5f), one = vset(1.0f);
+    const vf W = vset(float(ft.W)), H = vset(float(ft.H));
+    const vf nearp = vset(ft.nearp), farp = vset(ft.farp);
+    const vf guard = vset(GUARD_BAND);
+
+    alignas(32) int sx[SIMD_LANES], sy[SIMD_LANES];
+    alignas(32) float cx[SIMD_LANES], cy[SIMD_LANES], cd[SIMD_LANES], cw[SIMD_LANES];
+    alignas(32) float nx[SIMD_LANES], ny[SIMD_LANES], nz[SIMD_LANES];
+
+    size_t i = 0;
+    for (; i + SIMD_LANES <= n; i += SIMD_LANES) {
+        vf x = vload(&s.px[i]), y = vload(&s.py[i]), z = vload(&s.pz[i]);
+        vf vx = mrow(V, 0, x, y, z, 1.0f);
+        vf vy = mrow(V, 1, x, y, z, 1.0f);
+        vf vz = mrow(V, 2, x, y, z, 1.0f);
+
+        // clip space (mesma conta do Camera::clipVertex)
+        vf px = vmul(vx, vset(ft.sx));
+        vf py = vmul(vy, vset(ft.sy));
+        vf d = vsub(zero, vz);  // distancia da câmera
+        vf w = ft.ortho ? one : d;
+        vf g = vmul(guard, w);
+
+        int mNear = vmask(vlt(d, nearp)), mFar = vmask(vgt(d, farp));
+        int mLeft = vmask(vlt(px, vsub(zero, g))), mRight = vmask(vgt(px, g));
+        int mBottom = vmask(vlt(py, vsub(zero, g))), mTop = vmask(vgt(py, g));
+
+        // converte para pixel (truncando, como o cast para int); lanes fora
+        // do guard band são calculadas mas descartadas
+        vf xn = vdiv(px, w), yn = vdiv(py, w);
+        istore((uint32_t*)sx, vtoi(vmul(vadd(vmul(xn, half), half), W)));
+        istore((uint32_t*)sy, vtoi(vmul(vsub(one, vadd(vmul(yn, half), half)), H)));
+        vstore(cx, px);
+        vstore(cy, py);
+        vstore(cd, d);
+        vstore(cw, w);
+
+        // normais para o mundo (identidade fora de instâncias)
+        const glm::mat3& N = ft.normalMatrix;
+        x = vload(&s.nx[i]); y = vload(&s.ny[i]); z = vload(&s.nz[i]);
+        vstore(nx, nrow(N, 0, x, y, z));
+        vstore(ny, nrow(N, 1, x, y, z));
+        vstore(nz, nrow(N, 2, x, y, z));
+
+        for (int l = 0; l < SIMD_LANES; l++) {
+            size_t k = i + l;
+            uint8_t code = 0;
+            if ((mNear >> l) & 1) code |= CLIP_NEAR;
+            if ((mFar >> l) & 1) code |= CLIP_FAR;
+            if ((mLeft >> l) & 1) code |= CLIP_LEFT;
+            if ((mRight >> l) & 1) code |= CLIP_RIGHT;
+            if ((mBottom >> l) & 1) code |= CLIP_BOTTOM;
+            if ((mTop >> l) & 1) code |= CLIP_TOP;
+            cache.outcode[k] = code;
+            cache.clip[k] = {cx[l], cy[l], cd[l], cw[l]};
+
+            Vertex2D& o = cache.verts[k];
+            o.x = sx[l];
+            o.y = sy[l];
+            o.z = cd[l];
+            o.normal = glm::vec3(nx[l], ny[l], nz[l]);
+            o.intensity = 1.0f;
+        }
+    }
+
+    for (; i < n; i++) project_one(s, i, ft, cache);
+}
+
+#else  // sem SIMD: um vértice por vez
+
+void project_stream(const VertexStream& s, const FrameTransform& ft,
+                    VertexCache& cache) {
+    resize_cache(cache, s.size());
+    for (size_t i = 0; i < s.size(); i++) project_one(s, i, ft, cache);
+}
+
+#endif
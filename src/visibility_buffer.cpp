@@ -0,0 +1,179 @@
+#include "../include/visibility_buffer.h"
+
+#include <algorithm>
+
+#include "../include/fill_halfspace.h"
+
+// ------------------------- TRIANGULAÇÃO -------------------------
+
+static int cross2(const Vertex2D& a, const Vertex2D& b, const Vertex2D& c) {
+    return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+}
+
+static bool insideTri(const Vertex2D& p, const Vertex2D& a, const Vertex2D& b,
+                      const Vertex2D& c, int sign) {
+    return cross2(a, b, p) * sign >= 0 && cross2(b, c, p) * sign >= 0 &&
+           cross2(c, a, p) * sign >= 0;
+}
+
+// Ear clipping: as faces das extrusões podem ser côncavas, então o leque
+// simples não serve. Escreve triplas de índices em out.
+static void triangulate(const ArrayView<Vertex2D>& v, std::vector<int>& ring,
+                        std::vector<int>& out) {
+    out.clear();
+    int n = (int)v.size();
+
+    long long area2 = 0;
+    for (int i = 0; i < n; i++) area2 += cross2(v[0], v[i], v[(i + 1) % n]);
+    int sign = (area2 >= 0) ? 1 : -1;
+
+    ring.resize(n);
+    for (int i = 0; i < n; i++) ring[i] = i;
+
+    while (ring.size() > 3) {
+        int m = (int)ring.size();
+        bool clipped = false;
+
+        // começa pelo vértice 1: num polígono convexo isso reproduz o leque
+        // a partir do vértice 0, igual ao caminho half-space
+        for (int k = 1; k <= m; k++) {
+            int i = k % m;
+            int ia = ring[(i + m - 1) % m], ib = ring[i], ic = ring[(i + 1) % m];
+            if (cross2(v[ia], v[ib], v[ic]) * sign <= 0) continue;  // reflexo
+
+            bool ear = true;
+            for (int j = 0; j < m && ear; j++) {
+                int k = ring[j];
+                if (k == ia || k == ib || k == ic) continue;
+                if (insideTri(v[k], v[ia], v[ib], v[ic], sign)) ear = false;
+            }
+            if (!ear) continue;
+
+            out.push_back(ia);
+            out.push_back(ib);
+            out.push_back(ic);
+            ring.erase(ring.begin() + i);
+            clipped = true;
+            break;
+        }
+
+        if (!clipped) break;  // degenerado: o resto vai em leque
+    }
+
+    for (size_t i = 1; i + 1 < ring.size(); i++) {
+        out.push_back(ring[0]);
+        out.push_back(ring[i]);
+        out.push_back(ring[i + 1]);
+    }
+}
+
+// ------------------------- VISIBILITY BUFFER -------------------------
+
+void VisibilityBuffer::begin(int w, int h) {
+    if (w != W || h != H) {
+        W = w;
+        H = h;
+        ids.assign(W * H, NONE);
+    }
+    tris.clear();
+    materials.clear();
+}
+
+void VisibilityBuffer::submit(const Polygon& p, Framebuffer& fb) {
+    if (p.verts.size() < 3 || !p.material) return;
+
+    int bx0 = p.verts[0].x, bx1 = bx0;
+    int by0 = p.verts[0].y, by1 = by0;
+    float zmin = p.verts[0].z;
+    for (const auto& v : p.verts) {
+        bx0 = std::min(bx0, v.x);
+        bx1 = std::max(bx1, v.x);
+        by0 = std::min(by0, v.y);
+        by1 = std::max(by1, v.y);
+        zmin = std::min(zmin, v.z);
+    }
+    if (fb.occluded(bx0, by0, bx1, by1, zmin)) {
+        stats.hizRejects++;
+        return;
+    }
+
+    int material = (int)materials.size();
+    materials.push_back(*p.material);
+
+    triangulate(p.verts, ring, triIdx);
+
+    for (size_t t = 0; t + 2 < triIdx.size(); t += 3) {
+        VisTriangle tri;
+        tri.v[0] = p.verts[triIdx[t]];
+        tri.v[1] = p.verts[triIdx[t + 1]];
+        tri.v[2] = p.verts[triIdx[t + 2]];
+        tri.material = material;
+
+        int area = cross2(tri.v[0], tri.v[1], tri.v[2]);
+        if (area == 0) continue;
+        tri.invArea = 1.0f / float(area);
+
+        uint32_t id = (uint32_t)tris.size();
+        tris.push_back(tri);
+
+        // só profundidade + id: nenhuma iluminação nesta passada
+        halfspace_traverse(tri.v[0], tri.v[1], tri.v[2], W, H, ScreenRect(),
+                           [&](int x, int y, float la, float lb, float lc) {
+            float z = la * tri.v[0].z + lb * tri.v[1].z + lc * tri.v[2].z;
+            float& d = fb.depth(x, y);
+            if (z < d) {
+                d = z;
+                ids[y * W + x] = id;
+                if (uint16_t* overdraw = fb.overdrawRow(y)) overdraw[x]++;
+                stats.depthPasses++;
+            } else {
+                stats.depthRejects++;
+            }
+        });
+    }
+
+    fb.updateHiZ(bx0, by0, bx1, by1);
+
+    bx0 = std::max(bx0, 0);
+    by0 = std::max(by0, 0);
+    bx1 = std::min(bx1, W - 1);
+    by1 = std::min(by1, H - 1);
+    if (dirtyX0 > dirtyX1) {
+        dirtyX0 = bx0; dirtyY0 = by0;
+        dirtyX1 = bx1; dirtyY1 = by1;
+    } else {
+        dirtyX0 = std::min(dirtyX0, bx0);
+        dirtyY0 = std::min(dirtyY0, by0);
+        dirtyX1 = std::max(dirtyX1, bx1);
+        dirtyY1 = std::max(dirtyY1, by1);
+    }
+}
+
+void VisibilityBuffer::resolve(Framebuffer& fb, const Renderer& renderer) {
+    for (int y = dirtyY0; y <= dirtyY1; y++) {
+        for (int x = dirtyX0; x <= dirtyX1; x++) {
+            uint32_t& id = ids[y * W + x];
+            if (id == NONE) continue;
+
+            const VisTriangle& t = tris[id];
+            id = NONE;  // já deixa limpo para o próximo frame
+
+            const Vertex2D& a = t.v[0];
+            const Vertex2D& b = t.v[1];
+            const Vertex2D& c = t.v[2];
+
+            float lb = float((x - a.x) * (c.y - a.y) - (y - a.y) * (c.x - a.x)) * t.invArea;
+            float lc = float((b.x - a.x) * (y - a.y) - (b.y - a.y) * (x - a.x)) * t.invArea;
+            float la = 1.0f - lb - lc;
+
+            glm::vec3 n = a.normal * la + b.normal * lb + c.normal * lc;
+            glm::vec3 pos(x, y, fb.depth(x, y));
+
+            fb.setRaw(x, y, renderer.shade<ShadingMode::Phong>(materials[t.material], 0.0f, n, pos));
+            stats.pixelsShaded++;
+        }
+    }
+
+    dirtyX0 = dirtyY0 = 0;
+    dirtyX1 = dirtyY1 = -1;
+}
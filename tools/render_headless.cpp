@@ -0,0 +1,413 @@
+// Renderer offline: lê uma cena de um arquivo texto, desenha N frames pelo
+// mesmo caminho do app (SceneRenderer -> tiles -> fill_polygon) num
+// Framebuffer em memória e grava cada frame em PPM. Não abre janela nem
+// precisa de OpenGL, então roda em CI e em farm de render; os tempos por
+// frame servem de benchmark reproduzível.
+//
+// uso: render_headless <cena> [-o prefixo] [-n frames] [--no-write]
+//                       [--overdraw]
+//
+// --overdraw grava o mapa de overdraw (paint_overdraw) no lugar da cor.
+//
+// Formato da cena: um comando por linha, '#' começa comentário.
+//   size W H                      tamanho do frame (padrão 900 600)
+//   frames N                      frames a renderizar (padrão 1)
+//   projection perspective|ortho
+//   look X Y Z                    ponto focal da órbita
+//   orbit AZ EL DIST              pose da câmera (graus, graus, distância)
+//   spin DAZ DEL                  giro da órbita por frame (graus)
+//   light X Y Z [INTENSIDADE]
+//   shading flat|gouraud|phong|deferred
+//   raster scanline|halfspace
+//   fastmath on|off
+//   background R G B
+//   axes                          desenha os eixos X/Y/Z como no app
+//   material rubber|plastic|metal|stone
+//   color R G B
+//   doublesided on|off
+//   cube X Y Z SIZE
+//   sphere X Y Z R [STACKS SLICES]
+//   cylinder X Y Z R H [SLICES]
+//   pyramid X Y Z SIZE H
+//   extrude xy|xz|yz DEPTH X Y Z X Y Z X Y Z ...
+//   rotate AX AY AZ               gira o último objeto em torno do centro
+//   scale S                       escala o último objeto em torno do centro
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../include/bresenham.h"
+#include "../include/camera.h"
+#include "../include/clip_line.h"
+#include "../include/extrusion.h"
+#include "../include/frame_profiler.h"
+#include "../include/raster_stats.h"
+#include "../include/framebuffer.h"
+#include "../include/lines.h"
+#include "../include/renderer.h"
+#include "../include/scene_renderer.h"
+#include "../include/shapes.h"
+#include "../include/types.h"
+
+struct SceneFile {
+    int width = 900, height = 600;
+    int frames = 1;
+    float spinAz = 0.0f, spinEl = 0.0f;
+    Color background = {30, 30, 40, 255};
+    bool axes = false;
+};
+
+static bool parseOnOff(std::istringstream& in, bool& out) {
+    std::string v;
+    in >> v;
+    if (v == "on") out = true;
+    else if (v == "off") out = false;
+    else return false;
+    return true;
+}
+
+static bool parseColor(std::istringstream& in, Color& c) {
+    int r, g, b;
+    if (!(in >> r >> g >> b)) return false;
+    c = {uint8_t(std::clamp(r, 0, 255)), uint8_t(std::clamp(g, 0, 255)),
+         uint8_t(std::clamp(b, 0, 255)), 255};
+    return true;
+}
+
+// aplica M em torno do centro do objeto (como a rotação do modo Transform)
+static void aroundCenter(Shapes& shapes, SlotHandle h, const char* op,
+                         float a, float b, float c) {
+    Shape& s = shapes.objects[h];
+    glm::vec3 center = s.center();
+    s.translate(-center);
+    if (std::strcmp(op, "rotate") == 0) {
+        s.rotateX(a);
+        s.rotateY(b);
+        s.rotateZ(c);
+    } else {
+        s.scale(a);
+    }
+    s.translate(center);
+    shapes.refit(h);
+}
+
+static bool loadScene(const char* path, SceneFile& scene, Shapes& shapes,
+                      Camera& camera, Renderer& renderer, Lines& lines) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "nao consegui abrir a cena: " << path << "\n";
+        return false;
+    }
+
+    Material material = MATERIAL_RUBBER;
+    SlotHandle last;
+    float az = 0.0f, el = 0.0f, dist = 10.0f;
+    Light light;
+    light.pos = glm::vec3(5, 5, 5);
+
+    std::string line;
+    for (int lineNo = 1; std::getline(file, line); lineNo++) {
+        line = line.substr(0, line.find('#'));
+        std::istringstream in(line);
+        std::string cmd;
+        if (!(in >> cmd)) continue;
+
+        bool ok = true;
+        if (cmd == "size") {
+            ok = bool(in >> scene.width >> scene.height) && scene.width > 0 &&
+                 scene.height > 0;
+        } else if (cmd == "frames") {
+            ok = bool(in >> scene.frames) && scene.frames > 0;
+        } else if (cmd == "projection") {
+            std::string v;
+            in >> v;
+            if (v == "perspective") camera.type = Camera::ProjType::Perspective;
+            else if (v == "ortho") camera.type = Camera::ProjType::Ortho;
+            else ok = false;
+        } else if (cmd == "look") {
+            ok = bool(in >> camera.look.x >> camera.look.y >> camera.look.z);
+        } else if (cmd == "orbit") {
+            ok = bool(in >> az >> el >> dist);
+        } else if (cmd == "spin") {
+            ok = bool(in >> scene.spinAz >> scene.spinEl);
+        } else if (cmd == "light") {
+            ok = bool(in >> light.pos.x >> light.pos.y >> light.pos.z);
+            float intensity;
+            if (ok && in >> intensity) light.intensity = intensity;
+        } else if (cmd == "shading") {
+            std::string v;
+            in >> v;
+            if (v == "flat") renderer.setMode(ShadingMode::Flat);
+            else if (v == "gouraud") renderer.setMode(ShadingMode::Gouraud);
+            else if (v == "phong") renderer.setMode(ShadingMode::Phong);
+            else if (v == "deferred") renderer.setMode(ShadingMode::Deferred);
+            else ok = false;
+        } else if (cmd == "raster") {
+            std::string v;
+            in >> v;
+            if (v == "scanline") renderer.setRasterPath(RasterPath::Scanline);
+            else if (v == "halfspace") renderer.setRasterPath(RasterPath::HalfSpace);
+            else ok = false;
+        } else if (cmd == "fastmath") {
+            bool on;
+            ok = parseOnOff(in, on);
+            if (ok) renderer.setFastMath(on);
+        } else if (cmd == "background") {
+            ok = parseColor(in, scene.background);
+        } else if (cmd == "axes") {
+            scene.axes = true;
+        } else if (cmd == "material") {
+            std::string v;
+            in >> v;
+            Material m;
+            if (v == "rubber") m = MATERIAL_RUBBER;
+            else if (v == "plastic") m = MATERIAL_PLASTIC;
+            else if (v == "metal") m = MATERIAL_METAL;
+            else if (v == "stone") m = MATERIAL_STONE;
+            else ok = false;
+            if (ok) {
+                m.color = material.color;
+                m.doubleSided = material.doubleSided;
+                material = m;
+            }
+        } else if (cmd == "color") {
+            ok = parseColor(in, material.color);
+        } else if (cmd == "doublesided") {
+            ok = parseOnOff(in, material.doubleSided);
+        } else if (cmd == "cube") {
+            glm::vec3 c;
+            float size;
+            ok = bool(in >> c.x >> c.y >> c.z >> size);
+            if (ok) last = shapes.createCube(material, c, size);
+        } else if (cmd == "sphere") {
+            glm::vec3 c;
+            float r;
+            int stacks = 12, slices = 24;
+            ok = bool(in >> c.x >> c.y >> c.z >> r);
+            if (ok && in >> stacks) ok = bool(in >> slices);
+            if (ok) last = shapes.createSphere(material, c, r, stacks, slices);
+        } else if (cmd == "cylinder") {
+            glm::vec3 c;
+            float r, h;
+            int slices = 16;
+            ok = bool(in >> c.x >> c.y >> c.z >> r >> h);
+            if (ok) in >> slices;
+            if (ok) last = shapes.createCylinder(material, c, r, h, slices);
+        } else if (cmd == "pyramid") {
+            glm::vec3 c;
+            float size, h;
+            ok = bool(in >> c.x >> c.y >> c.z >> size >> h);
+            if (ok) last = shapes.createPyramid(material, c, size, h);
+        } else if (cmd == "extrude") {
+            std::string v;
+            float depth;
+            in >> v;
+            DrawPlane plane = DrawPlane::XY;
+            if (v == "xz") plane = DrawPlane::XZ;
+            else if (v == "yz") plane = DrawPlane::YZ;
+            else ok = (v == "xy");
+            std::vector<glm::vec3> base;
+            glm::vec3 p;
+            ok = ok && bool(in >> depth);
+            while (ok && in >> p.x >> p.y >> p.z) base.push_back(p);
+            ok = ok && base.size() >= 3;
+            if (ok) {
+                size_t before = shapes.objects.size();
+                buildExtrudedSolid(base, plane, depth, shapes, material);
+                if (shapes.objects.size() > before)
+                    last = shapes.objects.handleAt(shapes.objects.size() - 1);
+            }
+        } else if (cmd == "rotate" || cmd == "scale") {
+            float a = 0.0f, b = 0.0f, c = 0.0f;
+            ok = shapes.objects.contains(last) && bool(in >> a);
+            if (ok && cmd == "rotate") ok = bool(in >> b >> c);
+            if (ok) aroundCenter(shapes, last, cmd.c_str(), a, b, c);
+        } else {
+            ok = false;
+        }
+
+        if (!ok) {
+            std::cerr << path << ":" << lineNo << ": comando invalido: " << line
+                      << "\n";
+            return false;
+        }
+    }
+
+    camera.setOrbit(az, el, dist);
+    renderer.setLight(light);
+    if (scene.axes) {
+        lines.add({-5, 0, 0}, {5, 0, 0}, {255, 0, 0, 255}, 1);  // eixo X
+        lines.add({0, -5, 0}, {0, 5, 0}, {0, 255, 0, 255}, 1);  // eixo Y
+        lines.add({0, 0, -5}, {0, 0, 5}, {0, 0, 255, 255}, 1);  // eixo Z
+    }
+    return true;
+}
+
+static bool writePPM(const std::string& path, const Framebuffer& fb) {
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+
+    std::fprintf(f, "P6\n%d %d\n255\n", fb.width(), fb.height());
+    std::vector<unsigned char> row(size_t(fb.width()) * 3);
+    const uint32_t* px = fb.colorData();
+    for (int y = 0; y < fb.height(); y++) {
+        for (int x = 0; x < fb.width(); x++) {
+            uint32_t c = px[size_t(y) * fb.width() + x];  // RGBA little-endian
+            row[x * 3 + 0] = (unsigned char)(c);
+            row[x * 3 + 1] = (unsigned char)(c >> 8);
+            row[x * 3 + 2] = (unsigned char)(c >> 16);
+        }
+        std::fwrite(row.data(), 1, row.size(), f);
+    }
+    return std::fclose(f) == 0;
+}
+
+static void usage() {
+    std::cerr << "uso: render_headless <cena> [-o prefixo] [-n frames] "
+                 "[--no-write] [--overdraw]\n";
+}
+
+int main(int argc, char** argv) {
+    const char* scenePath = nullptr;
+    std::string prefix = "frame";
+    int framesOverride = 0;
+    bool write = true;
+    bool overdraw = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            prefix = argv[++i];
+        } else if (std::strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            framesOverride = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--no-write") == 0) {
+            write = false;
+        } else if (std::strcmp(argv[i], "--overdraw") == 0) {
+            overdraw = true;
+        } else if (!scenePath && argv[i][0] != '-') {
+            scenePath = argv[i];
+        } else {
+            usage();
+            return -1;
+        }
+    }
+    if (!scenePath) {
+        usage();
+        return -1;
+    }
+
+    SceneFile scene;
+    Shapes shapes;
+    Camera camera;
+    Renderer renderer;
+    Lines lines;
+    if (!loadScene(scenePath, scene, shapes, camera, renderer, lines))
+        return -1;
+    if (framesOverride > 0) scene.frames = framesOverride;
+
+    Framebuffer fb(scene.width, scene.height);
+    fb.setOverdrawTracking(overdraw);
+    SceneRenderer sceneRenderer;
+    FrameProfiler profiler;
+    sceneRenderer.setProfiler(&profiler);
+    const int W = scene.width, H = scene.height;
+
+    std::printf("%s: %dx%d, %d objetos, %d frames, %d threads\n", scenePath,
+                W, H, (int)shapes.objects.size(), scene.frames,
+                sceneRenderer.threadCount());
+
+    std::vector<double> times;
+    times.reserve(scene.frames);
+    RasterStats totals;
+    for (int frame = 0; frame < scene.frames; frame++) {
+        if (frame > 0 && (scene.spinAz != 0.0f || scene.spinEl != 0.0f)) {
+            camera.addX(scene.spinAz);
+            camera.addY(scene.spinEl);
+        }
+
+        // só o render entra no tempo; gravar o arquivo fica de fora
+        profiler.beginFrame();
+        auto t0 = std::chrono::steady_clock::now();
+
+        {
+            ProfileScope timer(&profiler, ProfileStage::Clear);
+            sceneRenderer.beginFrame();
+            fb.clear(scene.background);
+            fb.clearDepth(1000.0f);
+        }
+        renderer.setCameraEye(camera.eye);
+
+        FrameTransform ft = camera.frameTransform(W, H);
+        sceneRenderer.drawShapes(shapes, ft, renderer, fb);
+
+        {
+            ProfileScope timer(&profiler, ProfileStage::Lines);
+            for (const auto& l3 : lines.objects) {
+                Line2D l2;
+                if (!camera.projectLine(l3, l2, W, H)) continue;
+                if (!clipLineCohenSutherland(l2, 0, 0, W - 1, H - 1)) continue;
+                sceneRenderer.stats().linePixels += plot_line(l2, fb);
+            }
+        }
+
+        double ms = std::chrono::duration<double, std::milli>(
+                        std::chrono::steady_clock::now() - t0)
+                        .count();
+        times.push_back(ms);
+        std::printf("frame %4d  %8.3f ms\n", frame, ms);
+        totals.add(sceneRenderer.stats());
+
+        if (write) {
+            if (overdraw) paint_overdraw(fb);
+            char name[32];
+            std::snprintf(name, sizeof name, "_%04d.ppm", frame);
+            if (!writePPM(prefix + name, fb)) {
+                std::cerr << "nao consegui gravar " << prefix + name << "\n";
+                return -1;
+            }
+        }
+    }
+
+    std::vector<double> sorted = times;
+    std::sort(sorted.begin(), sorted.end());
+    double total = 0.0;
+    for (double t : times) total += t;
+    auto pct = [&](double p) {
+        return sorted[std::min(sorted.size() - 1, size_t(p * sorted.size()))];
+    };
+    std::printf("min %.3f  p50 %.3f  p99 %.3f  max %.3f  media %.3f ms "
+                "(%.1f fps)\n",
+                sorted.front(), pct(0.50), pct(0.99), sorted.back(),
+                total / times.size(), 1000.0 * times.size() / total);
+
+    // média por etapa (dos frames que ainda estão no anel do profiler)
+    profiler.beginFrame();  // fecha o último frame
+    FrameProfiler::Summary stages = profiler.summary();
+    std::printf("etapas (ms, media de %d frames):", stages.frames);
+    for (int k = 0; k < FrameProfiler::STAGES; k++) {
+        if (stages.stageMs[k] > 0.0f)
+            std::printf("  %s %.3f", FrameProfiler::stageName(ProfileStage(k)),
+                        stages.stageMs[k]);
+    }
+    std::printf("\n");
+
+    // contadores: média por frame
+    double n = double(times.size());
+    std::printf("poligonos %.0f (backface %.0f, recortados %.0f, hi-z %.0f)\n",
+                totals.polygonsSubmitted / n, totals.polygonsCulled / n,
+                totals.polygonsClipped / n, totals.hizRejects / n);
+    std::printf("pixels shaded %.0f  z passou %.0f  z falhou %.0f  "
+                "hi-z %.0f  linhas %.0f  overdraw %.2f\n",
+                totals.pixelsShaded / n, totals.depthPasses / n,
+                totals.depthRejects / n, totals.hizPixels / n,
+                totals.linePixels / n,
+                totals.depthPasses / n / (double(W) * H));
+    return 0;
+}